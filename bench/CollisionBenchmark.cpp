@@ -0,0 +1,195 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+// Compares the spatial hash broadphase used by Game::ResolveCollisions with
+// the previous all-pairs loop. Every frame each collider moves a little, the
+// broadphase is updated and every intersecting pair is counted.
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <SDL.h>
+
+#include "HandcrankEngine/SpatialHash.hpp"
+
+using namespace HandcrankEngine;
+
+namespace
+{
+
+const int FRAMES = 60;
+const float COLLIDER_SIZE = 16;
+const float COLLIDER_SPEED = 2;
+const float COLLIDER_DENSITY = 64 * 64;
+
+struct Collider
+{
+    SDL_FRect rect;
+    float velocityX;
+    float velocityY;
+};
+
+auto GenerateColliders(size_t count, float worldSize) -> std::vector<Collider>
+{
+    std::mt19937 gen(count);
+    std::uniform_real_distribution<float> position(0, worldSize);
+    std::uniform_real_distribution<float> velocity(-COLLIDER_SPEED,
+                                                   COLLIDER_SPEED);
+
+    std::vector<Collider> colliders;
+
+    colliders.reserve(count);
+
+    for (size_t i = 0; i < count; i += 1)
+    {
+        colliders.push_back(
+            {{position(gen), position(gen), COLLIDER_SIZE, COLLIDER_SIZE},
+             velocity(gen),
+             velocity(gen)});
+    }
+
+    return colliders;
+}
+
+void Move(std::vector<Collider> &colliders, float worldSize)
+{
+    for (auto &collider : colliders)
+    {
+        collider.rect.x += collider.velocityX;
+        collider.rect.y += collider.velocityY;
+
+        if (collider.rect.x < 0 || collider.rect.x > worldSize)
+        {
+            collider.velocityX = -collider.velocityX;
+        }
+
+        if (collider.rect.y < 0 || collider.rect.y > worldSize)
+        {
+            collider.velocityY = -collider.velocityY;
+        }
+    }
+}
+
+auto ElapsedMilliseconds(Uint64 start) -> double
+{
+    return (SDL_GetPerformanceCounter() - start) * 1000.0 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+auto RunAllPairs(std::vector<Collider> colliders, float worldSize,
+                 size_t &hits) -> double
+{
+    auto start = SDL_GetPerformanceCounter();
+
+    for (auto frame = 0; frame < FRAMES; frame += 1)
+    {
+        Move(colliders, worldSize);
+
+        const auto count = colliders.size();
+
+        for (size_t i = 0; i + 1 < count; i += 1)
+        {
+            for (auto j = i + 1; j < count; j += 1)
+            {
+                if (SDL_HasIntersectionF(&colliders[i].rect,
+                                         &colliders[j].rect) == SDL_TRUE)
+                {
+                    hits += 1;
+                }
+            }
+        }
+    }
+
+    return ElapsedMilliseconds(start) / FRAMES;
+}
+
+auto RunSpatialHash(std::vector<Collider> colliders, float worldSize,
+                    float cellSize, size_t &hits) -> double
+{
+    auto start = SDL_GetPerformanceCounter();
+
+    SpatialHash spatialHash(cellSize);
+
+    std::vector<size_t> ids;
+
+    ids.reserve(colliders.size());
+
+    for (const auto &collider : colliders)
+    {
+        ids.push_back(spatialHash.Insert(collider.rect));
+    }
+
+    for (auto frame = 0; frame < FRAMES; frame += 1)
+    {
+        Move(colliders, worldSize);
+
+        for (size_t i = 0; i < colliders.size(); i += 1)
+        {
+            spatialHash.Update(ids[i], colliders[i].rect);
+        }
+
+        spatialHash.ForEachCandidatePair(
+            [&](size_t idA, size_t idB)
+            {
+                if (SDL_HasIntersectionF(&colliders[idA].rect,
+                                         &colliders[idB].rect) == SDL_TRUE)
+                {
+                    hits += 1;
+                }
+            });
+    }
+
+    return ElapsedMilliseconds(start) / FRAMES;
+}
+
+} // namespace
+
+auto main(int argc, char *argv[]) -> int
+{
+    const std::vector<size_t> counts = {100, 1000, 10000};
+    const std::vector<float> cellSizes = {32, 64, 128};
+
+    std::printf("%-10s %-14s %12s %12s\n", "colliders", "broadphase",
+                "ms/frame", "hits");
+
+    for (const auto count : counts)
+    {
+        auto worldSize =
+            std::sqrt(static_cast<float>(count) * COLLIDER_DENSITY);
+
+        auto colliders = GenerateColliders(count, worldSize);
+
+        size_t allPairsHits = 0;
+
+        auto allPairsTime = RunAllPairs(colliders, worldSize, allPairsHits);
+
+        std::printf("%-10zu %-14s %12.3f %12zu\n", count, "all-pairs",
+                    allPairsTime, allPairsHits);
+
+        for (const auto cellSize : cellSizes)
+        {
+            size_t spatialHashHits = 0;
+
+            auto spatialHashTime =
+                RunSpatialHash(colliders, worldSize, cellSize, spatialHashHits);
+
+            char label[32];
+
+            std::snprintf(label, sizeof(label), "hash/%.0f", cellSize);
+
+            std::printf("%-10zu %-14s %12.3f %12zu%s\n", count, label,
+                        spatialHashTime, spatialHashHits,
+                        spatialHashHits == allPairsHits ? "" : " MISMATCH");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+// Measures how JobSystem throughput scales from a single thread up to the
+// hardware concurrency. ParallelFor spreads a fixed amount of per item work,
+// the submit test queues many small jobs against a single counter.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "HandcrankEngine/JobSystem.hpp"
+
+using namespace HandcrankEngine;
+
+namespace
+{
+
+const int ITERATIONS = 10;
+const size_t ITEM_COUNT = 1 << 18;
+const size_t JOB_COUNT = 1 << 14;
+const size_t ITEMS_PER_JOB = 16;
+
+auto Work(size_t index) -> float
+{
+    auto value = static_cast<float>(index);
+
+    for (auto i = 0; i < 16; i += 1)
+    {
+        value = std::sin(value) + std::cos(value);
+    }
+
+    return value;
+}
+
+auto ElapsedMilliseconds(std::chrono::steady_clock::time_point start)
+    -> double
+{
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+auto RunParallelFor(JobSystem &jobSystem, std::vector<float> &results)
+    -> double
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto iteration = 0; iteration < ITERATIONS; iteration += 1)
+    {
+        jobSystem.ParallelFor(results.size(), 0,
+                              [&results](size_t start, size_t end)
+                              {
+                                  for (auto i = start; i < end; i += 1)
+                                  {
+                                      results[i] = Work(i);
+                                  }
+                              });
+    }
+
+    return ElapsedMilliseconds(start) / ITERATIONS;
+}
+
+auto RunSubmit(JobSystem &jobSystem, std::vector<float> &results) -> double
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto iteration = 0; iteration < ITERATIONS; iteration += 1)
+    {
+        JobCounter counter;
+
+        for (size_t job = 0; job < JOB_COUNT; job += 1)
+        {
+            jobSystem.Submit(
+                [&results, job]
+                {
+                    for (auto i = job * ITEMS_PER_JOB;
+                         i < (job + 1) * ITEMS_PER_JOB; i += 1)
+                    {
+                        results[i] = Work(i);
+                    }
+                },
+                &counter);
+        }
+
+        jobSystem.Wait(counter);
+    }
+
+    return ElapsedMilliseconds(start) / ITERATIONS;
+}
+
+} // namespace
+
+auto main(int argc, char *argv[]) -> int
+{
+    const auto maxThreadCount = JobSystem::GetDefaultThreadCount();
+
+    std::vector<size_t> threadCounts;
+
+    for (size_t threadCount = 1; threadCount < maxThreadCount;
+         threadCount *= 2)
+    {
+        threadCounts.push_back(threadCount);
+    }
+
+    threadCounts.push_back(maxThreadCount);
+
+    std::vector<float> results(std::max(ITEM_COUNT, JOB_COUNT * ITEMS_PER_JOB));
+
+    std::printf("%-8s %-12s %12s %14s %10s\n", "threads", "test", "ms/iter",
+                "items/ms", "speedup");
+
+    double parallelForBaseline = 0;
+    double submitBaseline = 0;
+
+    for (const auto threadCount : threadCounts)
+    {
+        JobSystem jobSystem(threadCount);
+
+        auto parallelForTime = RunParallelFor(jobSystem, results);
+        auto submitTime = RunSubmit(jobSystem, results);
+
+        if (threadCount == 1)
+        {
+            parallelForBaseline = parallelForTime;
+            submitBaseline = submitTime;
+        }
+
+        std::printf("%-8zu %-12s %12.3f %14.0f %9.2fx\n", threadCount,
+                    "parallel-for", parallelForTime,
+                    ITEM_COUNT / parallelForTime,
+                    parallelForBaseline / parallelForTime);
+
+        std::printf("%-8zu %-12s %12.3f %14.0f %9.2fx\n", threadCount,
+                    "submit", submitTime,
+                    (JOB_COUNT * ITEMS_PER_JOB) / submitTime,
+                    submitBaseline / submitTime);
+    }
+
+    return 0;
+}
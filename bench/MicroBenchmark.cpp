@@ -0,0 +1,719 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+// Measures the cost of small engine functions that run many times a frame in
+// nanoseconds per operation. Each benchmark is calibrated to run for a fixed
+// time per sample, then sampled repeatedly and reported as the median with
+// the median absolute deviation as spread. Results with a spread above half
+// the regression threshold are marked as noisy, and are not compared against
+// the baseline when either run was noisy.
+//
+// Usage: handcrank-bench-micro [--filter TEXT] [--samples N]
+//                              [--sample-time MS] [--font PATH]
+//                              [--baseline PATH] [--update-baseline]
+//                              [--threshold PERCENT]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "HandcrankEngine/FontCache.hpp"
+#include "HandcrankEngine/HandcrankEngine.hpp"
+#include "HandcrankEngine/RectRenderObject.hpp"
+#include "HandcrankEngine/TextureCache.hpp"
+#include "HandcrankEngine/Utilities.hpp"
+
+using namespace HandcrankEngine;
+
+namespace
+{
+
+const int DEFAULT_SAMPLES = 21;
+const double DEFAULT_SAMPLE_TIME = 20;
+const double DEFAULT_THRESHOLD = 5;
+
+const char *const FONT_ENVIRONMENT_VARIABLE = "HANDCRANK_ENGINE_BENCH_FONT";
+
+const int CHAIN_DEPTH = 64;
+const int WIDE_CHILD_COUNT = 1000;
+const size_t QUADS_PER_BATCH = 256;
+
+struct Options
+{
+    int samples = DEFAULT_SAMPLES;
+
+    double sampleTime = DEFAULT_SAMPLE_TIME;
+
+    double threshold = DEFAULT_THRESHOLD;
+
+    std::string filter;
+    std::string font;
+    std::string baseline;
+
+    bool updateBaseline = false;
+};
+
+struct Benchmark
+{
+    std::string name;
+
+    // Run the operation the given number of times.
+    std::function<void(size_t)> run;
+};
+
+struct Result
+{
+    std::string name;
+
+    double median = 0;
+    double min = 0;
+    double spread = 0;
+};
+
+auto IsNoisy(const Result &result, double threshold) -> bool
+{
+    return result.spread > threshold / 2;
+}
+
+// Keep the compiler from removing work whose result is never used.
+template <typename T> inline void DoNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void *volatile sink;
+
+    sink = &value;
+#endif
+}
+
+auto ElapsedNanoseconds(std::chrono::steady_clock::time_point start) -> double
+{
+    return std::chrono::duration<double, std::nano>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+auto TimeIterations(const Benchmark &benchmark, size_t iterations) -> double
+{
+    auto start = std::chrono::steady_clock::now();
+
+    benchmark.run(iterations);
+
+    return ElapsedNanoseconds(start);
+}
+
+auto Median(std::vector<double> values) -> double
+{
+    std::sort(values.begin(), values.end());
+
+    return values[values.size() / 2];
+}
+
+auto RunBenchmark(const Benchmark &benchmark, const Options &options)
+    -> Result
+{
+    auto targetTime = options.sampleTime * 1e6;
+
+    size_t iterations = 1;
+
+    // Double the iterations until a sample takes long enough that timer
+    // resolution and call overhead don't matter, which also warms caches.
+    while (true)
+    {
+        auto elapsed = TimeIterations(benchmark, iterations);
+
+        if (elapsed >= targetTime)
+        {
+            break;
+        }
+
+        iterations = elapsed < targetTime / 16
+                         ? iterations * 16
+                         : static_cast<size_t>(static_cast<double>(iterations) *
+                                               targetTime / elapsed) +
+                               1;
+    }
+
+    std::vector<double> samples;
+
+    samples.reserve(options.samples);
+
+    for (auto i = 0; i < options.samples; i += 1)
+    {
+        samples.push_back(TimeIterations(benchmark, iterations) /
+                          static_cast<double>(iterations));
+    }
+
+    Result result;
+
+    result.name = benchmark.name;
+    result.median = Median(samples);
+    result.min = *std::min_element(samples.begin(), samples.end());
+
+    std::vector<double> deviations;
+
+    deviations.reserve(samples.size());
+
+    for (const auto sample : samples)
+    {
+        deviations.push_back(std::abs(sample - result.median));
+    }
+
+    result.spread = Median(deviations) / result.median * 100;
+
+    return result;
+}
+
+// BMP data for a small texture, loaded through the memory overload of
+// LoadCachedTexture so no image file is needed.
+auto CreateImageData() -> std::vector<char>
+{
+    std::vector<char> data(16 * 1024);
+
+    auto *surface =
+        SDL_CreateRGBSurfaceWithFormat(0, 16, 16, 32, SDL_PIXELFORMAT_RGBA32);
+
+    if (surface == nullptr)
+    {
+        return {};
+    }
+
+    auto *rw = SDL_RWFromMem(data.data(), static_cast<int>(data.size()));
+
+    SDL_SaveBMP_RW(surface, rw, 0);
+
+    data.resize(static_cast<size_t>(SDL_RWtell(rw)));
+
+    SDL_RWclose(rw);
+
+    SDL_FreeSurface(surface);
+
+    return data;
+}
+
+auto ReadFile(const std::string &path) -> std::vector<char>
+{
+    std::ifstream file(path, std::ios::binary);
+
+    return {std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()};
+}
+
+auto CreateBenchmarks(Game &game, const Options &options)
+    -> std::vector<Benchmark>
+{
+    std::vector<Benchmark> benchmarks;
+
+    auto chain = std::make_shared<RectRenderObject>(0, 0, 10, 10);
+
+    game.AddChildObject(chain);
+
+    RenderObject *leaf = chain.get();
+
+    for (auto depth = 1; depth < CHAIN_DEPTH; depth += 1)
+    {
+        auto child = std::make_shared<RectRenderObject>(1, 1, 10, 10);
+
+        leaf->AddChildObject(child);
+
+        leaf = child.get();
+    }
+
+    auto wide = std::make_shared<RectRenderObject>(0, 0, 10, 10);
+
+    game.AddChildObject(wide);
+
+    for (auto i = 0; i < WIDE_CHILD_COUNT; i += 1)
+    {
+        wide->AddChildObject(std::make_shared<RectRenderObject>(
+            static_cast<float>(i % 100), static_cast<float>(i / 100), 10, 10));
+    }
+
+    // Build the children buffers the bounding boxes are calculated from.
+    game.Loop();
+
+    benchmarks.push_back(
+        {"transform/leaf",
+         [leaf](size_t iterations)
+         {
+             for (size_t i = 0; i < iterations; i += 1)
+             {
+                 leaf->SetTransformedRect();
+
+                 DoNotOptimize(leaf->GetTransformedRect());
+             }
+         }});
+
+    benchmarks.push_back(
+        {"transform/chain-" + std::to_string(CHAIN_DEPTH),
+         [chain, leaf](size_t iterations)
+         {
+             for (size_t i = 0; i < iterations; i += 1)
+             {
+                 chain->SetPosition(static_cast<float>(i & 1), 0);
+
+                 DoNotOptimize(leaf->GetTransformedRect());
+             }
+         }});
+
+    benchmarks.push_back(
+        {"bounding-box/chain-" + std::to_string(CHAIN_DEPTH),
+         [chain, leaf](size_t iterations)
+         {
+             for (size_t i = 0; i < iterations; i += 1)
+             {
+                 leaf->SetBoundingBoxAsDirty();
+
+                 DoNotOptimize(chain->GetBoundingBox());
+             }
+         }});
+
+    benchmarks.push_back(
+        {"bounding-box/wide-" + std::to_string(WIDE_CHILD_COUNT),
+         [wide](size_t iterations)
+         {
+             for (size_t i = 0; i < iterations; i += 1)
+             {
+                 wide->SetBoundingBoxAsDirty();
+
+                 DoNotOptimize(wide->GetBoundingBox());
+             }
+         }});
+
+    auto imageData = std::make_shared<std::vector<char>>(CreateImageData());
+
+    if (!imageData->empty() &&
+        LoadCachedTexture(game.GetRenderer(), imageData->data(),
+                          static_cast<int>(imageData->size())) != nullptr)
+    {
+        benchmarks.push_back(
+            {"texture-cache/memory-hit",
+             [&game, imageData](size_t iterations)
+             {
+                 for (size_t i = 0; i < iterations; i += 1)
+                 {
+                     DoNotOptimize(LoadCachedTexture(
+                         game.GetRenderer(), imageData->data(),
+                         static_cast<int>(imageData->size())));
+                 }
+             }});
+
+        auto imagePath = std::make_shared<std::string>(
+            (std::filesystem::temp_directory_path() / "handcrank-bench.bmp")
+                .string());
+
+        std::ofstream(*imagePath, std::ios::binary)
+            .write(imageData->data(),
+                   static_cast<std::streamsize>(imageData->size()));
+
+        if (LoadCachedTexture(game.GetRenderer(), imagePath->c_str()) !=
+            nullptr)
+        {
+            benchmarks.push_back(
+                {"texture-cache/path-hit",
+                 [&game, imagePath](size_t iterations)
+                 {
+                     for (size_t i = 0; i < iterations; i += 1)
+                     {
+                         DoNotOptimize(LoadCachedTexture(game.GetRenderer(),
+                                                         imagePath->c_str()));
+                     }
+                 }});
+        }
+
+        std::error_code error;
+
+        std::filesystem::remove(*imagePath, error);
+    }
+
+    if (!options.font.empty() &&
+        LoadCachedFont(options.font.c_str(), DEFAULT_FONT_SIZE) != nullptr)
+    {
+        auto font = std::make_shared<std::string>(options.font);
+
+        benchmarks.push_back(
+            {"font-cache/path-hit",
+             [font](size_t iterations)
+             {
+                 for (size_t i = 0; i < iterations; i += 1)
+                 {
+                     DoNotOptimize(
+                         LoadCachedFont(font->c_str(), DEFAULT_FONT_SIZE));
+                 }
+             }});
+
+        auto fontData = std::make_shared<std::vector<char>>(ReadFile(*font));
+
+        if (!fontData->empty() &&
+            LoadCachedFont(fontData->data(), static_cast<int>(fontData->size()),
+                           DEFAULT_FONT_SIZE) != nullptr)
+        {
+            benchmarks.push_back(
+                {"font-cache/memory-hit",
+                 [fontData](size_t iterations)
+                 {
+                     for (size_t i = 0; i < iterations; i += 1)
+                     {
+                         DoNotOptimize(LoadCachedFont(
+                             fontData->data(),
+                             static_cast<int>(fontData->size()),
+                             DEFAULT_FONT_SIZE));
+                     }
+                 }});
+        }
+    }
+
+    auto input = std::make_shared<InputHandler>();
+
+    input->BindActionKey(0, SDLK_SPACE);
+
+    {
+        SDL_Event event{};
+
+        event.type = SDL_KEYDOWN;
+        event.key.keysym.sym = SDLK_SPACE;
+        event.key.keysym.scancode = SDL_SCANCODE_SPACE;
+
+        input->HandleInputSetup();
+        input->HandleInputPollEvent(event);
+        input->ResolveActions();
+    }
+
+    benchmarks.push_back({"input/is-key-down",
+                          [input](size_t iterations)
+                          {
+                              for (size_t i = 0; i < iterations; i += 1)
+                              {
+                                  DoNotOptimize(input->IsKeyDown(SDLK_SPACE));
+                              }
+                          }});
+
+    auto keyCodes = std::make_shared<std::vector<SDL_Keycode>>(
+        std::vector<SDL_Keycode>{SDLK_LEFT, SDLK_a, SDLK_SPACE});
+
+    benchmarks.push_back({"input/is-key-down-any-of-3",
+                          [input, keyCodes](size_t iterations)
+                          {
+                              for (size_t i = 0; i < iterations; i += 1)
+                              {
+                                  DoNotOptimize(input->IsKeyDown(*keyCodes));
+                              }
+                          }});
+
+    benchmarks.push_back(
+        {"input/is-scancode-pressed",
+         [input](size_t iterations)
+         {
+             for (size_t i = 0; i < iterations; i += 1)
+             {
+                 DoNotOptimize(input->IsScancodePressed(SDL_SCANCODE_SPACE));
+             }
+         }});
+
+    benchmarks.push_back({"input/is-action-down",
+                          [input](size_t iterations)
+                          {
+                              for (size_t i = 0; i < iterations; i += 1)
+                              {
+                                  DoNotOptimize(input->IsActionDown(0));
+                              }
+                          }});
+
+    auto vertices = std::make_shared<std::vector<SDL_Vertex>>();
+    auto indices = std::make_shared<std::vector<int>>();
+
+    vertices->reserve(QUADS_PER_BATCH * 4);
+    indices->reserve(QUADS_PER_BATCH * 6);
+
+    // Cleared every batch like a render batch is every frame, so the vectors
+    // don't grow and the measurement is of the quad generation alone.
+    benchmarks.push_back(
+        {"generate-texture-quad",
+         [vertices, indices](size_t iterations)
+         {
+             const SDL_FRect srcRect{0, 0, 16, 16};
+             const SDL_Color color{255, 255, 255, 255};
+
+             for (size_t i = 0; i < iterations; i += 1)
+             {
+                 if (i % QUADS_PER_BATCH == 0)
+                 {
+                     vertices->clear();
+                     indices->clear();
+                 }
+
+                 const SDL_FRect destRect{static_cast<float>(i & 255), 0, 16,
+                                          16};
+
+                 GenerateTextureQuad(*vertices, *indices, destRect, srcRect,
+                                     color, 256, 256);
+
+                 DoNotOptimize(vertices->data());
+             }
+         }});
+
+    for (const auto size :
+         {size_t{64} * 1024, size_t{1024} * 1024, size_t{16} * 1024 * 1024})
+    {
+        auto buffer = std::make_shared<std::vector<char>>(size);
+
+        for (size_t i = 0; i < size; i += 1)
+        {
+            (*buffer)[i] = static_cast<char>(i * 31);
+        }
+
+        benchmarks.push_back(
+            {"mem-hash/" + std::to_string(size / 1024) + "KB",
+             [buffer](size_t iterations)
+             {
+                 for (size_t i = 0; i < iterations; i += 1)
+                 {
+                     DoNotOptimize(MemHash(buffer->data(), buffer->size()));
+                 }
+             }});
+    }
+
+    benchmarks.push_back(
+        {"get-class-name-simple",
+         [chain](size_t iterations)
+         {
+             for (size_t i = 0; i < iterations; i += 1)
+             {
+                 DoNotOptimize(GetClassNameSimple(*chain));
+             }
+         }});
+
+    return benchmarks;
+}
+
+auto LoadBaseline(const std::string &path, std::vector<Result> &results)
+    -> bool
+{
+    std::ifstream file(path);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        std::istringstream stream(line);
+
+        Result result;
+
+        // Baselines written before the spread was stored have no spread.
+        if (stream >> result.name >> result.median)
+        {
+            stream >> result.spread;
+
+            results.push_back(result);
+        }
+    }
+
+    return true;
+}
+
+auto WriteBaseline(const std::string &path, const std::vector<Result> &results)
+    -> bool
+{
+    std::ofstream file(path);
+
+    if (!file)
+    {
+        std::fprintf(stderr, "Failed to write %s\n", path.c_str());
+
+        return false;
+    }
+
+    for (const auto &result : results)
+    {
+        char line[256];
+
+        std::snprintf(line, sizeof(line), "%s %.4f %.4f\n",
+                      result.name.c_str(), result.median, result.spread);
+
+        file << line;
+    }
+
+    return static_cast<bool>(file);
+}
+
+auto Compare(const std::vector<Result> &results,
+             const std::vector<Result> &baseline, double threshold) -> bool
+{
+    auto hasRegression = false;
+
+    for (const auto &result : results)
+    {
+        auto match = std::find_if(baseline.begin(), baseline.end(),
+                                  [&result](const Result &other)
+                                  { return other.name == result.name; });
+
+        if (match == baseline.end() || match->median <= 0)
+        {
+            continue;
+        }
+
+        auto change = (result.median - match->median) / match->median * 100;
+
+        if (IsNoisy(result, threshold) || IsNoisy(*match, threshold))
+        {
+            if (change > threshold)
+            {
+                std::fprintf(stderr,
+                             "NOISY %s: %.2f -> %.2f ns/op (%+.1f%%), "
+                             "not compared\n",
+                             result.name.c_str(), match->median,
+                             result.median, change);
+            }
+
+            continue;
+        }
+
+        if (change > threshold)
+        {
+            std::fprintf(stderr,
+                         "REGRESSION %s: %.2f -> %.2f ns/op (%+.1f%%)\n",
+                         result.name.c_str(), match->median, result.median,
+                         change);
+
+            hasRegression = true;
+        }
+    }
+
+    return hasRegression;
+}
+
+auto ParseOptions(int argc, char *argv[], Options &options) -> bool
+{
+    if (const auto *font = SDL_getenv(FONT_ENVIRONMENT_VARIABLE))
+    {
+        options.font = font;
+    }
+
+    for (auto i = 1; i < argc; i += 1)
+    {
+        std::string arg = argv[i];
+
+        auto hasValue = i + 1 < argc;
+
+        if (arg == "--filter" && hasValue)
+        {
+            options.filter = argv[++i];
+        }
+        else if (arg == "--samples" && hasValue)
+        {
+            options.samples = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--sample-time" && hasValue)
+        {
+            options.sampleTime = std::atof(argv[++i]);
+        }
+        else if (arg == "--font" && hasValue)
+        {
+            options.font = argv[++i];
+        }
+        else if (arg == "--baseline" && hasValue)
+        {
+            options.baseline = argv[++i];
+        }
+        else if (arg == "--threshold" && hasValue)
+        {
+            options.threshold = std::atof(argv[++i]);
+        }
+        else if (arg == "--update-baseline")
+        {
+            options.updateBaseline = true;
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument %s\n", arg.c_str());
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+auto main(int argc, char *argv[]) -> int
+{
+    Options options;
+
+    if (!ParseOptions(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    Game game(GameMode::HEADLESS);
+
+    std::vector<Result> results;
+
+    std::printf("%-28s %12s %12s %10s\n", "benchmark", "ns/op", "min",
+                "spread");
+
+    for (const auto &benchmark : CreateBenchmarks(game, options))
+    {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        auto result = RunBenchmark(benchmark, options);
+
+        std::printf("%-28s %12.2f %12.2f %9.2f%%%s\n", result.name.c_str(),
+                    result.median, result.min, result.spread,
+                    IsNoisy(result, options.threshold) ? " (noisy)" : "");
+
+        std::fflush(stdout);
+
+        results.push_back(result);
+    }
+
+    if (options.baseline.empty())
+    {
+        return EXIT_SUCCESS;
+    }
+
+    std::vector<Result> baseline;
+
+    if (options.updateBaseline || !LoadBaseline(options.baseline, baseline))
+    {
+        std::fprintf(stderr, "Writing baseline %s\n", options.baseline.c_str());
+
+        return WriteBaseline(options.baseline, results) ? EXIT_SUCCESS
+                                                        : EXIT_FAILURE;
+    }
+
+    if (Compare(results, baseline, options.threshold))
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::fprintf(stderr, "No regressions over %.1f%%\n", options.threshold);
+
+    return EXIT_SUCCESS;
+}
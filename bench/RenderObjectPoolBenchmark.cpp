@@ -0,0 +1,119 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+// Compares spawning and destroying short-lived objects with std::make_shared
+// against acquiring them from a RenderObjectPool. Every frame a wave of
+// bullets is added to a headless game, the children buffer is rebuilt, then
+// every bullet is destroyed and removed.
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <SDL.h>
+
+#include "HandcrankEngine/HandcrankEngine.hpp"
+#include "HandcrankEngine/RenderObjectPool.hpp"
+
+using namespace HandcrankEngine;
+
+namespace
+{
+
+const int FRAMES = 200;
+
+class Bullet : public RenderObject
+{
+  public:
+    float velocityX = 0;
+    float velocityY = 0;
+
+    void OnReuse() override
+    {
+        velocityX = 0;
+        velocityY = 0;
+    }
+};
+
+auto ElapsedMilliseconds(Uint64 start) -> double
+{
+    return (SDL_GetPerformanceCounter() - start) * 1000.0 /
+           static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+template <typename Spawn>
+auto Run(Game &game, size_t count, Spawn spawn) -> double
+{
+    std::vector<std::shared_ptr<Bullet>> bullets;
+
+    bullets.reserve(count);
+
+    auto start = SDL_GetPerformanceCounter();
+
+    for (auto frame = 0; frame < FRAMES; frame += 1)
+    {
+        for (size_t i = 0; i < count; i += 1)
+        {
+            auto bullet = spawn();
+
+            bullet->SetPosition(static_cast<float>(i), 0);
+            bullet->velocityX = 1;
+
+            game.AddChildObject(bullet);
+
+            bullets.emplace_back(bullet);
+        }
+
+        game.PopulateChildrenBuffer();
+
+        for (const auto &bullet : bullets)
+        {
+            bullet->Destroy();
+        }
+
+        bullets.clear();
+
+        game.DestroyChildObjects();
+
+        game.PopulateChildrenBuffer();
+    }
+
+    return ElapsedMilliseconds(start) / FRAMES;
+}
+
+} // namespace
+
+auto main(int argc, char *argv[]) -> int
+{
+    const std::vector<size_t> counts = {100, 1000, 10000};
+
+    Game game(GameMode::HEADLESS);
+
+    std::printf("%-10s %-14s %12s %14s\n", "objects", "spawn", "ms/frame",
+                "spawns/ms");
+
+    for (const auto count : counts)
+    {
+        auto sharedTime =
+            Run(game, count, [] { return std::make_shared<Bullet>(); });
+
+        std::printf("%-10zu %-14s %12.3f %14.0f\n", count, "make_shared",
+                    sharedTime, count / sharedTime);
+
+        RenderObjectPool<Bullet> pool(count);
+
+        auto poolTime = Run(game, count, [&pool] { return pool.Acquire(); });
+
+        std::printf("%-10zu %-14s %12.3f %14.0f%s\n", count, "pool", poolTime,
+                    count / poolTime,
+                    pool.GetCapacity() == count ? "" : " GREW");
+    }
+
+    return 0;
+}
@@ -0,0 +1,744 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+// Runs stress scenes in a headless game and reports frame time percentiles,
+// allocations and render calls per frame as JSON. Results can be compared
+// against a baseline file from an earlier run, any scene that got slower or
+// does more work than the threshold allows is flagged and the benchmark
+// exits with a non-zero status.
+//
+// Built with HANDCRANK_ENGINE_DEBUG and HANDCRANK_ENGINE_TRACK_ALLOCATIONS so
+// render and allocation counts are available.
+//
+// Usage: handcrank-bench [--frames N] [--warmup N] [--scene NAME]
+//                        [--font PATH] [--output PATH] [--baseline PATH]
+//                        [--update-baseline] [--threshold PERCENT]
+
+#define HANDCRANK_ENGINE_TRACK_ALLOCATIONS_IMPLEMENTATION
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "HandcrankEngine/HandcrankEngine.hpp"
+#include "HandcrankEngine/RectRenderObject.hpp"
+#include "HandcrankEngine/SpriteRenderObject.hpp"
+#include "HandcrankEngine/TextRenderObject.hpp"
+
+using namespace HandcrankEngine;
+
+namespace
+{
+
+const int DEFAULT_FRAMES = 300;
+const int DEFAULT_WARMUP_FRAMES = 30;
+const double DEFAULT_THRESHOLD = 10;
+const double FIXED_DELTA_TIME = 1.0 / 60;
+
+const char *const FONT_ENVIRONMENT_VARIABLE = "HANDCRANK_ENGINE_BENCH_FONT";
+
+const int SPRITE_FRAME_SIZE = 16;
+const int SPRITE_FRAME_COUNT = 4;
+
+struct Options
+{
+    int frames = DEFAULT_FRAMES;
+    int warmupFrames = DEFAULT_WARMUP_FRAMES;
+
+    double threshold = DEFAULT_THRESHOLD;
+
+    std::string scene;
+    std::string font;
+    std::string output;
+    std::string baseline;
+
+    bool updateBaseline = false;
+};
+
+struct SceneResult
+{
+    std::string name;
+
+    bool skipped = false;
+
+    int frames = 0;
+
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+
+    double allocations = 0;
+    double allocatedBytes = 0;
+
+    double renderCalls = 0;
+    double textureBinds = 0;
+};
+
+struct Scene
+{
+    const char *name;
+
+    // Populate the game, or return false to skip the scene.
+    std::function<bool(Game &, const Options &)> setup;
+};
+
+std::mt19937 gen(1);
+
+auto RandomFloat(float min, float max) -> float
+{
+    return std::uniform_real_distribution<float>(min, max)(gen);
+}
+
+class MovingRect : public RectRenderObject
+{
+  public:
+    float velocityX = 0;
+    float velocityY = 0;
+
+    int collisions = 0;
+
+    using RectRenderObject::RectRenderObject;
+
+    void Update(double deltaTime) override
+    {
+        auto rect = GetRect();
+
+        rect.x += velocityX;
+        rect.y += velocityY;
+
+        if (rect.x < 0 || rect.x + rect.w > game->GetWidth())
+        {
+            velocityX = -velocityX;
+        }
+
+        if (rect.y < 0 || rect.y + rect.h > game->GetHeight())
+        {
+            velocityY = -velocityY;
+        }
+
+        SetPosition(rect.x, rect.y);
+    }
+
+    void OnCollision(const std::shared_ptr<RenderObject> &other) override
+    {
+        collisions += 1;
+    }
+};
+
+auto CreateMovingRect(Game &game, float size) -> std::shared_ptr<MovingRect>
+{
+    auto rect = std::make_shared<MovingRect>(
+        RandomFloat(0, static_cast<float>(game.GetWidth()) - size),
+        RandomFloat(0, static_cast<float>(game.GetHeight()) - size), size,
+        size);
+
+    rect->SetFillColor({255, 255, 255, 255});
+
+    rect->velocityX = RandomFloat(-2, 2);
+    rect->velocityY = RandomFloat(-2, 2);
+
+    return rect;
+}
+
+class ChangingText : public TextRenderObject
+{
+  private:
+    std::string content;
+
+    int counter = 0;
+
+  public:
+    using TextRenderObject::TextRenderObject;
+
+    void Update(double deltaTime) override
+    {
+        counter += 1;
+
+        content = "Frame " + std::to_string(counter);
+
+        SetText(content.c_str());
+    }
+};
+
+class SwayingObject : public RectRenderObject
+{
+  private:
+    double elapsed = 0;
+
+  public:
+    using RectRenderObject::RectRenderObject;
+
+    void Update(double deltaTime) override
+    {
+        elapsed += deltaTime;
+
+        SetPosition(GetRect().x + static_cast<float>(std::sin(elapsed)),
+                    GetRect().y);
+    }
+};
+
+auto CreateSpriteSheet(SDL_Renderer *renderer) -> std::shared_ptr<SDL_Texture>
+{
+    auto *surface = SDL_CreateRGBSurfaceWithFormat(
+        0, SPRITE_FRAME_SIZE * SPRITE_FRAME_COUNT, SPRITE_FRAME_SIZE, 32,
+        SDL_PIXELFORMAT_RGBA32);
+
+    if (surface == nullptr)
+    {
+        return nullptr;
+    }
+
+    for (auto i = 0; i < SPRITE_FRAME_COUNT; i += 1)
+    {
+        SDL_Rect frame{i * SPRITE_FRAME_SIZE, 0, SPRITE_FRAME_SIZE,
+                       SPRITE_FRAME_SIZE};
+
+        SDL_FillRect(surface, &frame,
+                     SDL_MapRGBA(surface->format, 64 * i, 255 - (64 * i), 128,
+                                 255));
+    }
+
+    auto texture = std::shared_ptr<SDL_Texture>(
+        SDL_CreateTextureFromSurface(renderer, surface), SDL_DestroyTexture);
+
+    SDL_FreeSurface(surface);
+
+    return texture;
+}
+
+auto CreateScenes() -> std::vector<Scene>
+{
+    return {
+        {"rects",
+         [](Game &game, const Options &options)
+         {
+             for (auto i = 0; i < 10000; i += 1)
+             {
+                 game.AddChildObject(CreateMovingRect(game, 8));
+             }
+
+             return true;
+         }},
+        {"sprites",
+         [](Game &game, const Options &options)
+         {
+             auto texture = CreateSpriteSheet(game.GetRenderer());
+
+             if (texture == nullptr)
+             {
+                 return false;
+             }
+
+             for (auto i = 0; i < 10000; i += 1)
+             {
+                 auto sprite = std::make_shared<SpriteRenderObject>(
+                     RandomFloat(0, static_cast<float>(game.GetWidth())),
+                     RandomFloat(0, static_cast<float>(game.GetHeight())));
+
+                 sprite->SetSharedTexture(texture);
+                 sprite->CalculateFrames(SPRITE_FRAME_SIZE, SPRITE_FRAME_SIZE,
+                                         SPRITE_FRAME_COUNT, 1, Vector2(0, 0),
+                                         Vector2(0, 0));
+                 sprite->SetFrameSpeed(RandomFloat(0.05F, 0.2F));
+                 sprite->Play();
+
+                 game.AddChildObject(sprite);
+             }
+
+             return true;
+         }},
+        {"colliders",
+         [](Game &game, const Options &options)
+         {
+             for (auto i = 0; i < 2000; i += 1)
+             {
+                 auto rect = CreateMovingRect(game, 12);
+
+                 game.AddChildObject(rect);
+
+                 rect->EnableCollider();
+             }
+
+             return true;
+         }},
+        {"text",
+         [](Game &game, const Options &options)
+         {
+             if (options.font.empty())
+             {
+                 return false;
+             }
+
+             for (auto i = 0; i < 500; i += 1)
+             {
+                 auto text = std::make_shared<ChangingText>(
+                     RandomFloat(0, static_cast<float>(game.GetWidth())),
+                     RandomFloat(0, static_cast<float>(game.GetHeight())));
+
+                 text->LoadFont(options.font.c_str(), 16);
+
+                 game.AddChildObject(text);
+             }
+
+             return true;
+         }},
+        {"deep-hierarchy",
+         [](Game &game, const Options &options)
+         {
+             for (auto chain = 0; chain < 20; chain += 1)
+             {
+                 auto parent = std::make_shared<SwayingObject>(
+                     RandomFloat(0, static_cast<float>(game.GetWidth())), 0, 4,
+                     4);
+
+                 game.AddChildObject(parent);
+
+                 RenderObject *current = parent.get();
+
+                 for (auto depth = 0; depth < 250; depth += 1)
+                 {
+                     auto child = std::make_shared<SwayingObject>(0, 2, 4, 4);
+
+                     child->SetFillColor({255, 255, 255, 255});
+
+                     current->AddChildObject(child);
+
+                     current = child.get();
+                 }
+             }
+
+             return true;
+         }},
+        {"wide-hierarchy",
+         [](Game &game, const Options &options)
+         {
+             for (auto group = 0; group < 10; group += 1)
+             {
+                 auto parent = std::make_shared<SwayingObject>(
+                     0, 0, static_cast<float>(game.GetWidth()),
+                     static_cast<float>(game.GetHeight()));
+
+                 game.AddChildObject(parent);
+
+                 for (auto i = 0; i < 1000; i += 1)
+                 {
+                     auto child = std::make_shared<SwayingObject>(
+                         RandomFloat(0, static_cast<float>(game.GetWidth())),
+                         RandomFloat(0, static_cast<float>(game.GetHeight())),
+                         4, 4);
+
+                     child->SetFillColor({255, 255, 255, 255});
+
+                     parent->AddChildObject(child);
+                 }
+             }
+
+             return true;
+         }},
+    };
+}
+
+auto Percentile(std::vector<double> sorted, double percentile) -> double
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    auto index = static_cast<size_t>(percentile / 100.0 *
+                                     static_cast<double>(sorted.size() - 1));
+
+    return sorted[index];
+}
+
+auto RunScene(const Scene &scene, const Options &options) -> SceneResult
+{
+    SceneResult result;
+
+    result.name = scene.name;
+
+    Game game(GameMode::HEADLESS);
+
+    game.SetFixedDeltaTime(FIXED_DELTA_TIME);
+
+    gen.seed(1);
+
+    if (!scene.setup(game, options))
+    {
+        result.skipped = true;
+
+        return result;
+    }
+
+    for (auto frame = 0; frame < options.warmupFrames; frame += 1)
+    {
+        game.Loop();
+    }
+
+    std::vector<double> frameTimes;
+
+    frameTimes.reserve(options.frames);
+
+    auto frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+    for (auto frame = 0; frame < options.frames; frame += 1)
+    {
+        auto start = SDL_GetPerformanceCounter();
+
+        game.Loop();
+
+        frameTimes.push_back((SDL_GetPerformanceCounter() - start) * 1000.0 /
+                             frequency);
+
+        auto allocationStats = AllocationTracker::Get().GetFrameStats();
+
+        result.allocations += static_cast<double>(allocationStats.count);
+        result.allocatedBytes += static_cast<double>(allocationStats.bytes);
+
+        const auto &renderStats = game.GetRenderStats();
+
+        result.renderCalls += renderStats.renderCalls;
+        result.textureBinds += renderStats.textureBinds;
+    }
+
+    std::sort(frameTimes.begin(), frameTimes.end());
+
+    result.frames = options.frames;
+
+    result.p50 = Percentile(frameTimes, 50);
+    result.p90 = Percentile(frameTimes, 90);
+    result.p99 = Percentile(frameTimes, 99);
+    result.max = frameTimes.empty() ? 0 : frameTimes.back();
+
+    if (options.frames > 0)
+    {
+        result.allocations /= options.frames;
+        result.allocatedBytes /= options.frames;
+        result.renderCalls /= options.frames;
+        result.textureBinds /= options.frames;
+    }
+
+    return result;
+}
+
+// Each scene is written on its own line so baselines can be read back
+// without a JSON parser.
+auto ToJSON(const std::vector<SceneResult> &results) -> std::string
+{
+    std::ostringstream json;
+
+    json << "{\n  \"scenes\": [\n";
+
+    for (size_t i = 0; i < results.size(); i += 1)
+    {
+        const auto &result = results[i];
+
+        char line[512];
+
+        if (result.skipped)
+        {
+            std::snprintf(line, sizeof(line),
+                          "    {\"name\": \"%s\", \"skipped\": true}",
+                          result.name.c_str());
+        }
+        else
+        {
+            std::snprintf(
+                line, sizeof(line),
+                "    {\"name\": \"%s\", \"frames\": %d, \"p50\": %.4f, "
+                "\"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f, "
+                "\"allocations\": %.2f, \"allocatedBytes\": %.2f, "
+                "\"renderCalls\": %.2f, \"textureBinds\": %.2f}",
+                result.name.c_str(), result.frames, result.p50, result.p90,
+                result.p99, result.max, result.allocations,
+                result.allocatedBytes, result.renderCalls,
+                result.textureBinds);
+        }
+
+        json << line << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    json << "  ]\n}\n";
+
+    return json.str();
+}
+
+auto FindString(const std::string &line, const char *key) -> std::string
+{
+    auto pattern = std::string("\"") + key + "\": \"";
+
+    auto start = line.find(pattern);
+
+    if (start == std::string::npos)
+    {
+        return "";
+    }
+
+    start += pattern.size();
+
+    return line.substr(start, line.find('"', start) - start);
+}
+
+auto FindNumber(const std::string &line, const char *key, double &value)
+    -> bool
+{
+    auto pattern = std::string("\"") + key + "\": ";
+
+    auto start = line.find(pattern);
+
+    if (start == std::string::npos)
+    {
+        return false;
+    }
+
+    value = std::strtod(line.c_str() + start + pattern.size(), nullptr);
+
+    return true;
+}
+
+auto LoadBaseline(const std::string &path, std::vector<SceneResult> &results)
+    -> bool
+{
+    std::ifstream file(path);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        SceneResult result;
+
+        result.name = FindString(line, "name");
+
+        if (result.name.empty() ||
+            line.find("\"skipped\"") != std::string::npos)
+        {
+            continue;
+        }
+
+        FindNumber(line, "p50", result.p50);
+        FindNumber(line, "p90", result.p90);
+        FindNumber(line, "p99", result.p99);
+        FindNumber(line, "allocations", result.allocations);
+        FindNumber(line, "renderCalls", result.renderCalls);
+        FindNumber(line, "textureBinds", result.textureBinds);
+
+        results.push_back(result);
+    }
+
+    return true;
+}
+
+// Counts are compared with an absolute allowance as well, so a scene that
+// went from 0 to a fraction of an allocation per frame isn't flagged.
+auto CheckRegression(const char *scene, const char *metric, double current,
+                     double baseline, double threshold, double allowance)
+    -> bool
+{
+    if (current <= baseline * (1 + threshold / 100) + allowance)
+    {
+        return false;
+    }
+
+    std::fprintf(stderr, "REGRESSION %s %s: %.4f -> %.4f (%+.1f%%)\n", scene,
+                 metric, baseline, current,
+                 baseline > 0 ? (current - baseline) / baseline * 100 : 100.0);
+
+    return true;
+}
+
+auto Compare(const std::vector<SceneResult> &results,
+             const std::vector<SceneResult> &baseline, double threshold)
+    -> bool
+{
+    auto hasRegression = false;
+
+    for (const auto &result : results)
+    {
+        if (result.skipped)
+        {
+            continue;
+        }
+
+        auto match = std::find_if(baseline.begin(), baseline.end(),
+                                  [&result](const SceneResult &other)
+                                  { return other.name == result.name; });
+
+        if (match == baseline.end())
+        {
+            std::fprintf(stderr, "%s: no baseline\n", result.name.c_str());
+
+            continue;
+        }
+
+        const auto *name = result.name.c_str();
+
+        hasRegression |= CheckRegression(name, "p50", result.p50, match->p50,
+                                         threshold, 0);
+        hasRegression |= CheckRegression(name, "p90", result.p90, match->p90,
+                                         threshold, 0);
+        hasRegression |=
+            CheckRegression(name, "allocations", result.allocations,
+                            match->allocations, threshold, 0.5);
+        hasRegression |=
+            CheckRegression(name, "renderCalls", result.renderCalls,
+                            match->renderCalls, threshold, 0.5);
+        hasRegression |=
+            CheckRegression(name, "textureBinds", result.textureBinds,
+                            match->textureBinds, threshold, 0.5);
+    }
+
+    return hasRegression;
+}
+
+auto WriteFile(const std::string &path, const std::string &content) -> bool
+{
+    std::ofstream file(path);
+
+    if (!file)
+    {
+        std::fprintf(stderr, "Failed to write %s\n", path.c_str());
+
+        return false;
+    }
+
+    file << content;
+
+    return static_cast<bool>(file);
+}
+
+auto ParseOptions(int argc, char *argv[], Options &options) -> bool
+{
+    if (const auto *font = SDL_getenv(FONT_ENVIRONMENT_VARIABLE))
+    {
+        options.font = font;
+    }
+
+    for (auto i = 1; i < argc; i += 1)
+    {
+        std::string arg = argv[i];
+
+        auto hasValue = i + 1 < argc;
+
+        if (arg == "--frames" && hasValue)
+        {
+            options.frames = std::atoi(argv[++i]);
+        }
+        else if (arg == "--warmup" && hasValue)
+        {
+            options.warmupFrames = std::atoi(argv[++i]);
+        }
+        else if (arg == "--scene" && hasValue)
+        {
+            options.scene = argv[++i];
+        }
+        else if (arg == "--font" && hasValue)
+        {
+            options.font = argv[++i];
+        }
+        else if (arg == "--output" && hasValue)
+        {
+            options.output = argv[++i];
+        }
+        else if (arg == "--baseline" && hasValue)
+        {
+            options.baseline = argv[++i];
+        }
+        else if (arg == "--threshold" && hasValue)
+        {
+            options.threshold = std::atof(argv[++i]);
+        }
+        else if (arg == "--update-baseline")
+        {
+            options.updateBaseline = true;
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument %s\n", arg.c_str());
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+auto main(int argc, char *argv[]) -> int
+{
+    Options options;
+
+    if (!ParseOptions(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::vector<SceneResult> results;
+
+    for (const auto &scene : CreateScenes())
+    {
+        if (!options.scene.empty() && options.scene != scene.name)
+        {
+            continue;
+        }
+
+        std::fprintf(stderr, "Running %s\n", scene.name);
+
+        results.push_back(RunScene(scene, options));
+    }
+
+    auto json = ToJSON(results);
+
+    std::fputs(json.c_str(), stdout);
+
+    if (!options.output.empty() && !WriteFile(options.output, json))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (options.baseline.empty())
+    {
+        return EXIT_SUCCESS;
+    }
+
+    std::vector<SceneResult> baseline;
+
+    if (options.updateBaseline || !LoadBaseline(options.baseline, baseline))
+    {
+        std::fprintf(stderr, "Writing baseline %s\n", options.baseline.c_str());
+
+        return WriteFile(options.baseline, json) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (Compare(results, baseline, options.threshold))
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::fprintf(stderr, "No regressions over %.1f%%\n", options.threshold);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,511 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#define HANDCRANK_ALLOCATION_CONCAT_INNER(a, b) a##b
+#define HANDCRANK_ALLOCATION_CONCAT(a, b)                                      \
+    HANDCRANK_ALLOCATION_CONCAT_INNER(a, b)
+
+#ifdef HANDCRANK_ENGINE_TRACK_ALLOCATIONS
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <SDL.h>
+
+#include "Utilities.hpp"
+
+namespace HandcrankEngine
+{
+
+inline const size_t ALLOCATION_TRACKER_CLASS_CAPACITY = 256;
+
+inline const uint64_t DEFAULT_ALLOCATION_WARMUP_FRAMES = 120;
+
+enum class AllocationPhase : uint8_t
+{
+    OTHER,
+    INPUT,
+    UPDATE,
+    FIXED_UPDATE,
+    COLLISIONS,
+    RENDER,
+    DESTROY,
+    COUNT
+};
+
+inline const size_t ALLOCATION_PHASE_COUNT =
+    static_cast<size_t>(AllocationPhase::COUNT);
+
+[[nodiscard]] inline auto GetAllocationPhaseName(AllocationPhase phase) -> const
+    char *
+{
+    switch (phase)
+    {
+    case AllocationPhase::INPUT:
+        return "Input";
+    case AllocationPhase::UPDATE:
+        return "Update";
+    case AllocationPhase::FIXED_UPDATE:
+        return "FixedUpdate";
+    case AllocationPhase::COLLISIONS:
+        return "Collisions";
+    case AllocationPhase::RENDER:
+        return "Render";
+    case AllocationPhase::DESTROY:
+        return "Destroy";
+    default:
+        return "Other";
+    }
+}
+
+struct AllocationStats
+{
+    uint64_t count = 0;
+
+    uint64_t bytes = 0;
+};
+
+/**
+ * Counts every call to global operator new, attributed to the phase of
+ * Game::Loop it happened in and to the class of the RenderObject being
+ * updated or rendered at the time. Per phase counts are kept for the last
+ * frame and since the start, per class counts since the start.
+ *
+ * With the assert enabled, any frame after the warmup that allocates is
+ * logged and aborts, so allocations creeping into steady state frames are
+ * caught as soon as they happen.
+ */
+class AllocationTracker
+{
+  private:
+    struct Counter
+    {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    struct ClassEntry
+    {
+        const std::type_info *type;
+
+        AllocationStats stats;
+    };
+
+    std::atomic<AllocationPhase> phase{AllocationPhase::OTHER};
+
+    std::array<Counter, ALLOCATION_PHASE_COUNT> frameCounters;
+
+    std::array<AllocationStats, ALLOCATION_PHASE_COUNT> lastFrameStats{};
+
+    std::array<AllocationStats, ALLOCATION_PHASE_COUNT> totalStats{};
+
+    std::array<ClassEntry, ALLOCATION_TRACKER_CLASS_CAPACITY> classEntries{};
+
+    std::mutex classMutex;
+
+    uint64_t frameCount = 0;
+
+    uint64_t warmupFrames = DEFAULT_ALLOCATION_WARMUP_FRAMES;
+
+    bool isAssertEnabled = false;
+
+    // Allocations made by the tracker itself, or while it holds a lock, are
+    // counted without being attributed to a class.
+    [[nodiscard]] static auto IsRecording() -> bool &
+    {
+        thread_local bool isRecording = false;
+
+        return isRecording;
+    }
+
+    void RecordClass(const std::type_info *type, size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(classMutex);
+
+        auto slot = std::hash<const void *>{}(type) %
+                    ALLOCATION_TRACKER_CLASS_CAPACITY;
+
+        for (size_t i = 0; i < ALLOCATION_TRACKER_CLASS_CAPACITY; i += 1)
+        {
+            auto &entry =
+                classEntries[(slot + i) % ALLOCATION_TRACKER_CLASS_CAPACITY];
+
+            if (entry.type == nullptr || entry.type == type)
+            {
+                entry.type = type;
+                entry.stats.count += 1;
+                entry.stats.bytes += bytes;
+
+                return;
+            }
+        }
+    }
+
+  public:
+    [[nodiscard]] static auto Get() -> AllocationTracker &
+    {
+        static AllocationTracker tracker;
+
+        return tracker;
+    }
+
+    [[nodiscard]] static auto CurrentType() -> const std::type_info *&
+    {
+        thread_local const std::type_info *type = nullptr;
+
+        return type;
+    }
+
+    /**
+     * Count an allocation. Called from global operator new, so it must not
+     * allocate.
+     *
+     * @param bytes Requested size in bytes.
+     */
+    void Record(size_t bytes)
+    {
+        auto &isRecording = IsRecording();
+
+        auto &counter = frameCounters[static_cast<size_t>(
+            phase.load(std::memory_order_relaxed))];
+
+        counter.count.fetch_add(1, std::memory_order_relaxed);
+        counter.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+        if (isRecording)
+        {
+            return;
+        }
+
+        if (const auto *type = CurrentType())
+        {
+            isRecording = true;
+
+            RecordClass(type, bytes);
+
+            isRecording = false;
+        }
+    }
+
+    [[nodiscard]] auto GetPhase() const -> AllocationPhase
+    {
+        return phase.load(std::memory_order_relaxed);
+    }
+
+    void SetPhase(AllocationPhase phase)
+    {
+        this->phase.store(phase, std::memory_order_relaxed);
+    }
+
+    /**
+     * Finish a frame. Per phase counts move to the last frame stats and are
+     * added to the totals.
+     */
+    void EndFrame()
+    {
+        AllocationStats frameTotal;
+
+        for (size_t i = 0; i < ALLOCATION_PHASE_COUNT; i += 1)
+        {
+            auto &stats = lastFrameStats[i];
+
+            stats.count = frameCounters[i].count.exchange(0);
+            stats.bytes = frameCounters[i].bytes.exchange(0);
+
+            totalStats[i].count += stats.count;
+            totalStats[i].bytes += stats.bytes;
+
+            frameTotal.count += stats.count;
+            frameTotal.bytes += stats.bytes;
+        }
+
+        frameCount += 1;
+
+        if (isAssertEnabled && frameCount > warmupFrames &&
+            frameTotal.count > 0)
+        {
+            for (size_t i = 0; i < ALLOCATION_PHASE_COUNT; i += 1)
+            {
+                if (lastFrameStats[i].count > 0)
+                {
+                    SDL_Log("Frame %llu allocated %llu times (%llu bytes) in "
+                            "%s",
+                            static_cast<unsigned long long>(frameCount),
+                            static_cast<unsigned long long>(
+                                lastFrameStats[i].count),
+                            static_cast<unsigned long long>(
+                                lastFrameStats[i].bytes),
+                            GetAllocationPhaseName(
+                                static_cast<AllocationPhase>(i)));
+                }
+            }
+
+            std::abort();
+        }
+    }
+
+    /**
+     * Abort when a frame allocates once the warmup is over.
+     *
+     * @param warmupFrames Number of frames allowed to allocate while caches
+     * and buffers fill up.
+     */
+    void EnableAssert(uint64_t warmupFrames = DEFAULT_ALLOCATION_WARMUP_FRAMES)
+    {
+        this->warmupFrames = warmupFrames;
+
+        isAssertEnabled = true;
+    }
+
+    void DisableAssert() { isAssertEnabled = false; }
+
+    [[nodiscard]] auto IsAssertEnabled() const -> bool
+    {
+        return isAssertEnabled;
+    }
+
+    [[nodiscard]] auto GetFrameCount() const -> uint64_t { return frameCount; }
+
+    [[nodiscard]] auto GetFrameStats(AllocationPhase phase) const
+        -> AllocationStats
+    {
+        return lastFrameStats[static_cast<size_t>(phase)];
+    }
+
+    [[nodiscard]] auto GetFrameStats() const -> AllocationStats
+    {
+        AllocationStats frameTotal;
+
+        for (const auto &stats : lastFrameStats)
+        {
+            frameTotal.count += stats.count;
+            frameTotal.bytes += stats.bytes;
+        }
+
+        return frameTotal;
+    }
+
+    [[nodiscard]] auto GetTotalStats(AllocationPhase phase) const
+        -> AllocationStats
+    {
+        return totalStats[static_cast<size_t>(phase)];
+    }
+
+    /**
+     * Get allocation totals per RenderObject class, most bytes first.
+     */
+    [[nodiscard]] auto GetClassStats()
+        -> std::vector<std::pair<std::string, AllocationStats>>
+    {
+        std::vector<ClassEntry> entries;
+
+        {
+            auto &isRecording = IsRecording();
+
+            auto wasRecording = isRecording;
+
+            isRecording = true;
+
+            std::lock_guard<std::mutex> lock(classMutex);
+
+            for (const auto &entry : classEntries)
+            {
+                if (entry.type != nullptr)
+                {
+                    entries.emplace_back(entry);
+                }
+            }
+
+            isRecording = wasRecording;
+        }
+
+        std::vector<std::pair<std::string, AllocationStats>> results;
+
+        results.reserve(entries.size());
+
+        for (const auto &entry : entries)
+        {
+            results.emplace_back(GetTypeNameSimple(*entry.type), entry.stats);
+        }
+
+        std::sort(results.begin(), results.end(),
+                  [](const auto &a, const auto &b)
+                  { return a.second.bytes > b.second.bytes; });
+
+        return results;
+    }
+
+    /**
+     * Log allocation totals per phase and per class.
+     */
+    void PrintSummary()
+    {
+        SDL_Log("Allocations over %llu frames",
+                static_cast<unsigned long long>(frameCount));
+
+        for (size_t i = 0; i < ALLOCATION_PHASE_COUNT; i += 1)
+        {
+            SDL_Log("  %-12s %10llu allocations %12llu bytes",
+                    GetAllocationPhaseName(static_cast<AllocationPhase>(i)),
+                    static_cast<unsigned long long>(totalStats[i].count),
+                    static_cast<unsigned long long>(totalStats[i].bytes));
+        }
+
+        for (const auto &[name, stats] : GetClassStats())
+        {
+            SDL_Log("  %-24s %10llu allocations %12llu bytes", name.c_str(),
+                    static_cast<unsigned long long>(stats.count),
+                    static_cast<unsigned long long>(stats.bytes));
+        }
+    }
+};
+
+/**
+ * Attributes allocations to a phase until the end of the scope.
+ */
+class AllocationPhaseScope
+{
+  private:
+    AllocationPhase previous;
+
+  public:
+    explicit AllocationPhaseScope(AllocationPhase phase)
+        : previous(AllocationTracker::Get().GetPhase())
+    {
+        AllocationTracker::Get().SetPhase(phase);
+    }
+
+    AllocationPhaseScope(const AllocationPhaseScope &) = delete;
+    auto operator=(const AllocationPhaseScope &)
+        -> AllocationPhaseScope & = delete;
+
+    ~AllocationPhaseScope() { AllocationTracker::Get().SetPhase(previous); }
+};
+
+/**
+ * Attributes allocations on this thread to a class until the end of the
+ * scope.
+ */
+class AllocationObjectScope
+{
+  private:
+    const std::type_info *previous;
+
+  public:
+    explicit AllocationObjectScope(const std::type_info &type)
+        : previous(AllocationTracker::CurrentType())
+    {
+        AllocationTracker::CurrentType() = &type;
+    }
+
+    AllocationObjectScope(const AllocationObjectScope &) = delete;
+    auto operator=(const AllocationObjectScope &)
+        -> AllocationObjectScope & = delete;
+
+    ~AllocationObjectScope() { AllocationTracker::CurrentType() = previous; }
+};
+
+} // namespace HandcrankEngine
+
+// Replacing the global operators is only allowed once per program, so they
+// are only defined in the translation unit that defines
+// HANDCRANK_ENGINE_TRACK_ALLOCATIONS_IMPLEMENTATION before including the
+// engine. Over-aligned allocations are not counted.
+
+#ifdef HANDCRANK_ENGINE_TRACK_ALLOCATIONS_IMPLEMENTATION
+
+void *operator new(std::size_t size)
+{
+    HandcrankEngine::AllocationTracker::Get().Record(size);
+
+    if (auto *pointer = std::malloc(size > 0 ? size : 1))
+    {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t & /*unused*/) noexcept
+{
+    HandcrankEngine::AllocationTracker::Get().Record(size);
+
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &nothrow) noexcept
+{
+    return operator new(size, nothrow);
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t /*unused*/) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t /*unused*/) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t & /*unused*/) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer,
+                       const std::nothrow_t & /*unused*/) noexcept
+{
+    std::free(pointer);
+}
+
+#endif
+
+#define HANDCRANK_ALLOCATION_PHASE(phase)                                      \
+    HandcrankEngine::AllocationPhaseScope HANDCRANK_ALLOCATION_CONCAT(         \
+        allocationPhase, __LINE__)(HandcrankEngine::AllocationPhase::phase)
+
+#define HANDCRANK_ALLOCATION_OBJECT(object)                                    \
+    HandcrankEngine::AllocationObjectScope HANDCRANK_ALLOCATION_CONCAT(        \
+        allocationObject, __LINE__)(typeid(object))
+
+#define HANDCRANK_ALLOCATION_END_FRAME()                                       \
+    HandcrankEngine::AllocationTracker::Get().EndFrame()
+
+#define HANDCRANK_ALLOCATION_SUMMARY()                                         \
+    HandcrankEngine::AllocationTracker::Get().PrintSummary()
+
+#else
+
+#define HANDCRANK_ALLOCATION_PHASE(phase)
+
+#define HANDCRANK_ALLOCATION_OBJECT(object)
+
+#define HANDCRANK_ALLOCATION_END_FRAME()
+
+#define HANDCRANK_ALLOCATION_SUMMARY()
+
+#endif
@@ -0,0 +1,213 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace HandcrankEngine
+{
+
+inline const size_t DEFAULT_ANIMATION_SCHEDULER_SIZE = 64;
+
+class AnimationScheduler;
+
+/**
+ * Something the animation scheduler advances every frame while it is
+ * scheduled, such as an Animator.
+ */
+class ScheduledAnimation
+{
+    friend class AnimationScheduler;
+
+  private:
+    AnimationScheduler *scheduler = nullptr;
+
+  protected:
+    inline void Unschedule();
+
+  public:
+    ScheduledAnimation() = default;
+
+    ScheduledAnimation(const ScheduledAnimation &) = delete;
+    auto operator=(const ScheduledAnimation &) -> ScheduledAnimation & = delete;
+
+    inline virtual ~ScheduledAnimation();
+
+    [[nodiscard]] auto IsScheduled() const -> bool
+    {
+        return scheduler != nullptr;
+    }
+
+    /**
+     * Advance by a frame.
+     *
+     * @param deltaTime Seconds since the last frame.
+     *
+     * @return false once there is nothing left to advance, which removes it
+     * from the scheduler.
+     */
+    virtual auto AdvanceAnimation(double deltaTime) -> bool = 0;
+};
+
+/**
+ * Advances only the animations that are running, once per frame. Animations
+ * add themselves when they start or resume and are removed when they pause
+ * or complete, so idle animations cost nothing per frame.
+ */
+class AnimationScheduler
+{
+  private:
+    std::vector<ScheduledAnimation *> animations;
+
+    bool isStepping = false;
+
+    bool hasRemovedDuringStep = false;
+
+  public:
+    AnimationScheduler()
+    {
+        animations.reserve(DEFAULT_ANIMATION_SCHEDULER_SIZE);
+    }
+
+    AnimationScheduler(const AnimationScheduler &) = delete;
+    auto operator=(const AnimationScheduler &) -> AnimationScheduler & = delete;
+
+    ~AnimationScheduler()
+    {
+        for (auto *animation : animations)
+        {
+            if (animation != nullptr)
+            {
+                animation->scheduler = nullptr;
+            }
+        }
+    }
+
+    /**
+     * Start advancing an animation every frame. Animations added while
+     * stepping are first advanced in the same step.
+     *
+     * @param animation Animation to add.
+     */
+    void Add(ScheduledAnimation *animation)
+    {
+        if (animation->scheduler == this)
+        {
+            return;
+        }
+
+        if (animation->scheduler != nullptr)
+        {
+            animation->scheduler->Remove(animation);
+        }
+
+        animation->scheduler = this;
+
+        animations.push_back(animation);
+    }
+
+    /**
+     * Stop advancing an animation.
+     *
+     * @param animation Animation to remove.
+     */
+    void Remove(ScheduledAnimation *animation)
+    {
+        if (animation->scheduler != this)
+        {
+            return;
+        }
+
+        animation->scheduler = nullptr;
+
+        auto match = std::find(animations.begin(), animations.end(), animation);
+
+        if (match == animations.end())
+        {
+            return;
+        }
+
+        // Leave a gap while stepping so indexes stay valid, it is compacted
+        // once the step is done.
+        if (isStepping)
+        {
+            *match = nullptr;
+
+            hasRemovedDuringStep = true;
+        }
+        else
+        {
+            animations.erase(match);
+        }
+    }
+
+    /**
+     * Advance every scheduled animation, in the order they were added.
+     *
+     * @param deltaTime Seconds since the last frame.
+     */
+    void Step(double deltaTime)
+    {
+        isStepping = true;
+
+        for (size_t i = 0; i < animations.size(); i += 1)
+        {
+            auto *animation = animations[i];
+
+            if (animation != nullptr && !animation->AdvanceAnimation(deltaTime))
+            {
+                // The animation may have removed itself while advancing.
+                if (animations[i] == animation)
+                {
+                    animation->scheduler = nullptr;
+
+                    animations[i] = nullptr;
+
+                    hasRemovedDuringStep = true;
+                }
+            }
+        }
+
+        isStepping = false;
+
+        if (hasRemovedDuringStep)
+        {
+            animations.erase(
+                std::remove(animations.begin(), animations.end(), nullptr),
+                animations.end());
+
+            hasRemovedDuringStep = false;
+        }
+    }
+
+    [[nodiscard]] auto GetActiveCount() const -> size_t
+    {
+        return static_cast<size_t>(
+            std::count_if(animations.begin(), animations.end(),
+                          [](const auto *animation)
+                          { return animation != nullptr; }));
+    }
+};
+
+ScheduledAnimation::~ScheduledAnimation() { Unschedule(); }
+
+/**
+ * Remove from the scheduler advancing this, if any.
+ */
+void ScheduledAnimation::Unschedule()
+{
+    if (scheduler != nullptr)
+    {
+        scheduler->Remove(this);
+    }
+}
+
+} // namespace HandcrankEngine
@@ -17,7 +17,13 @@ namespace HandcrankEngine
 
 inline const int DEFAULT_ANIMATION_VECTOR_SIZE = 10;
 
-class Animator : public RenderObject
+/**
+ * Runs a list of animations in parallel or in sequence. While running, the
+ * animator is advanced by the game's AnimationScheduler rather than the
+ * render tree, so idle, paused and completed animators cost nothing per
+ * frame.
+ */
+class Animator : public RenderObject, public ScheduledAnimation
 {
   public:
     enum class State : uint8_t
@@ -43,21 +49,32 @@ class Animator : public RenderObject
 
     std::vector<std::shared_ptr<Animation>> animations;
 
+    // Animations still running in parallel mode, so finished ones are not
+    // checked again until the animator restarts.
+    std::vector<Animation *> runningAnimations;
+
     size_t currentAnimationIndex = 0;
 
   public:
     using RenderObject::RenderObject;
 
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(Animator);
+    }
+
     explicit Animator(const Mode mode)
     {
         this->mode = mode;
         this->animations.reserve(DEFAULT_ANIMATION_VECTOR_SIZE);
+        this->runningAnimations.reserve(DEFAULT_ANIMATION_VECTOR_SIZE);
     }
     explicit Animator(const Mode mode, bool looping)
     {
         this->mode = mode;
         this->looping = looping;
         this->animations.reserve(DEFAULT_ANIMATION_VECTOR_SIZE);
+        this->runningAnimations.reserve(DEFAULT_ANIMATION_VECTOR_SIZE);
     }
 
     void Start() override
@@ -88,6 +105,8 @@ class Animator : public RenderObject
         }
 
         currentState = State::PAUSED;
+
+        Unschedule();
     }
 
     void Resume()
@@ -101,6 +120,8 @@ class Animator : public RenderObject
         }
 
         currentState = State::RUNNING;
+
+        Schedule();
     }
 
     [[nodiscard]] auto GetState() const -> const State &
@@ -108,7 +129,19 @@ class Animator : public RenderObject
         return currentState;
     }
 
-    void SetState(State state) { currentState = state; }
+    void SetState(State state)
+    {
+        currentState = state;
+
+        if (currentState == State::RUNNING)
+        {
+            Schedule();
+        }
+        else
+        {
+            Unschedule();
+        }
+    }
 
     [[nodiscard]] auto GetMode() const -> const Mode & { return mode; }
 
@@ -143,16 +176,26 @@ class Animator : public RenderObject
             }));
     }
 
-    void Update(double deltaTime) override
+    /**
+     * Called by the animation scheduler once per frame while running.
+     *
+     * @param deltaTime Seconds since the last frame.
+     *
+     * @return false once the animator is no longer running.
+     */
+    auto AdvanceAnimation(double deltaTime) -> bool override
     {
-        if (!game->HasFocus())
+        if (HasBeenMarkedForDestroy() || currentState != State::RUNNING ||
+            animations.empty())
         {
-            return;
+            return false;
         }
 
-        if (animations.empty())
+        // Stay scheduled but hold still while it or an ancestor is disabled,
+        // as the render tree would have skipped updating it.
+        if (!IsEnabledInHierarchy())
         {
-            return;
+            return true;
         }
 
         if (mode == Mode::PARALLEL)
@@ -163,17 +206,54 @@ class Animator : public RenderObject
         {
             UpdateSequence(deltaTime);
         }
+
+        return currentState == State::RUNNING;
     }
 
   private:
+    void Schedule()
+    {
+        if (game == nullptr || HasBeenMarkedForDestroy())
+        {
+            return;
+        }
+
+        if (game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this] { Schedule(); });
+
+            return;
+        }
+
+        game->GetAnimationScheduler().Add(this);
+    }
+
+    void Unschedule()
+    {
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this] { Unschedule(); });
+
+            return;
+        }
+
+        ScheduledAnimation::Unschedule();
+    }
+
     void StartParallel()
     {
+        runningAnimations.clear();
+
         for (const auto &animation : animations)
         {
             animation->Start();
+
+            runningAnimations.push_back(animation.get());
         }
 
         currentState = State::RUNNING;
+
+        Schedule();
     }
 
     void StartSequence()
@@ -186,6 +266,8 @@ class Animator : public RenderObject
         }
 
         currentState = State::RUNNING;
+
+        Schedule();
     }
 
     void UpdateParallel(double deltaTime)
@@ -195,20 +277,23 @@ class Animator : public RenderObject
             return;
         }
 
-        auto stillRunning = false;
+        // Drop finished animations in place, keeping the rest in order.
+        auto stillRunning = runningAnimations.begin();
 
-        for (const auto &animation : animations)
+        for (auto *animation : runningAnimations)
         {
-            if (animation->GetState() == Animation::State::RUNNING)
+            if (animation->GetState() == Animation::State::RUNNING &&
+                animation->Tick(deltaTime) != 0)
             {
-                if (animation->Tick(deltaTime) != 0)
-                {
-                    stillRunning = true;
-                }
+                *stillRunning = animation;
+
+                ++stillRunning;
             }
         }
 
-        if (!stillRunning)
+        runningAnimations.erase(stillRunning, runningAnimations.end());
+
+        if (runningAnimations.empty())
         {
             if (looping)
             {
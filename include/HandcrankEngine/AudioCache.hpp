@@ -13,6 +13,7 @@
 
 #include <SDL_mixer.h>
 
+#include "ResourceCache.hpp"
 #include "Utilities.hpp"
 
 namespace HandcrankEngine
@@ -24,18 +25,45 @@ namespace
 {
 bool audioIsOpen = false;
 
-inline std::unordered_map<std::size_t, std::shared_ptr<Mix_Music>>
-    audioMusicCache =
-        std::unordered_map<std::size_t, std::shared_ptr<Mix_Music>>();
-inline std::unordered_map<std::size_t, std::shared_ptr<Mix_Chunk>>
-    audioSFXCache =
-        std::unordered_map<std::size_t, std::shared_ptr<Mix_Chunk>>();
+inline ResourceCache<Mix_Music> audioMusicCache;
+inline ResourceCache<Mix_Chunk> audioSFXCache;
 } // namespace
 
 inline auto ClearAudioCache() -> void
 {
-    audioMusicCache.clear();
-    audioSFXCache.clear();
+    audioMusicCache.Clear();
+    audioSFXCache.Clear();
+}
+
+/**
+ * Set the memory budget for cached music, estimated from the file size.
+ * Least recently used music that is only referenced by the cache is freed
+ * once the budget is exceeded.
+ *
+ * @param bytes Budget in bytes, 0 for unlimited.
+ */
+inline void SetMusicCacheBudget(size_t bytes)
+{
+    audioMusicCache.SetBudget(bytes);
+}
+
+/**
+ * Set the memory budget for cached sound effects, using the decoded chunk
+ * length. Least recently used sound effects that are only referenced by the
+ * cache are freed once the budget is exceeded.
+ *
+ * @param bytes Budget in bytes, 0 for unlimited.
+ */
+inline void SetSFXCacheBudget(size_t bytes) { audioSFXCache.SetBudget(bytes); }
+
+[[nodiscard]] inline auto GetMusicCacheSize() -> size_t
+{
+    return audioMusicCache.GetTotalBytes();
+}
+
+[[nodiscard]] inline auto GetSFXCacheSize() -> size_t
+{
+    return audioSFXCache.GetTotalBytes();
 }
 
 struct MixMusicDeleter
@@ -82,11 +110,9 @@ inline auto LoadCachedMusic(const char *path) -> std::shared_ptr<Mix_Music>
 {
     auto cacheKey = std::hash<std::string_view>{}(std::string_view(path));
 
-    auto match = audioMusicCache.find(cacheKey);
-
-    if (match != audioMusicCache.end())
+    if (auto music = audioMusicCache.Find(cacheKey))
     {
-        return match->second;
+        return music;
     }
 
     if (SetupAudio() != 0)
@@ -102,7 +128,7 @@ inline auto LoadCachedMusic(const char *path) -> std::shared_ptr<Mix_Music>
         return nullptr;
     }
 
-    audioMusicCache.insert_or_assign(cacheKey, music);
+    audioMusicCache.Insert(cacheKey, music, GetFileSize(path));
 
     return music;
 }
@@ -112,11 +138,9 @@ inline auto LoadCachedMusic(const void *mem, int size)
 {
     auto cacheKey = MemHash(mem, size);
 
-    auto match = audioMusicCache.find(cacheKey);
-
-    if (match != audioMusicCache.end())
+    if (auto music = audioMusicCache.Find(cacheKey))
     {
-        return match->second;
+        return music;
     }
 
     auto *rw = SDL_RWFromConstMem(mem, size);
@@ -139,7 +163,7 @@ inline auto LoadCachedMusic(const void *mem, int size)
         return nullptr;
     }
 
-    audioMusicCache.insert_or_assign(cacheKey, music);
+    audioMusicCache.Insert(cacheKey, music, size);
 
     return music;
 }
@@ -148,11 +172,9 @@ inline auto LoadCachedSFX(const char *path) -> std::shared_ptr<Mix_Chunk>
 {
     auto cacheKey = std::hash<std::string_view>{}(std::string_view(path));
 
-    auto match = audioSFXCache.find(cacheKey);
-
-    if (match != audioSFXCache.end())
+    if (auto sfx = audioSFXCache.Find(cacheKey))
     {
-        return match->second;
+        return sfx;
     }
 
     if (SetupAudio() != 0)
@@ -167,7 +189,7 @@ inline auto LoadCachedSFX(const char *path) -> std::shared_ptr<Mix_Chunk>
         return nullptr;
     }
 
-    audioSFXCache.insert_or_assign(cacheKey, sfx);
+    audioSFXCache.Insert(cacheKey, sfx, sfx->alen);
 
     return sfx;
 }
@@ -177,11 +199,9 @@ inline auto LoadCachedSFX(const void *mem, int size)
 {
     auto cacheKey = MemHash(mem, size);
 
-    auto match = audioSFXCache.find(cacheKey);
-
-    if (match != audioSFXCache.end())
+    if (auto sfx = audioSFXCache.Find(cacheKey))
     {
-        return match->second;
+        return sfx;
     }
 
     auto *rw = SDL_RWFromConstMem(mem, size);
@@ -204,7 +224,7 @@ inline auto LoadCachedSFX(const void *mem, int size)
         return nullptr;
     }
 
-    audioSFXCache.insert_or_assign(cacheKey, sfx);
+    audioSFXCache.Insert(cacheKey, sfx, sfx->alen);
 
     return sfx;
 }
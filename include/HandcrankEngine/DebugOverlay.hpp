@@ -0,0 +1,222 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdarg>
+#include <cstdio>
+
+#include <SDL.h>
+
+#include "HandcrankEngine.hpp"
+#include "TextRenderObject.hpp"
+
+namespace HandcrankEngine
+{
+
+inline const size_t DEBUG_OVERLAY_TEXT_CAPACITY = 4096;
+
+inline const double DEFAULT_DEBUG_OVERLAY_REFRESH_INTERVAL = 0.25;
+
+inline const double BYTES_PER_MEGABYTE = 1024.0 * 1024.0;
+
+/**
+ * Text drawn over the scene with engine statistics, refreshed a few times a
+ * second. Set a font before adding it to the game. The text is built into a
+ * fixed buffer and drawn with the glyph atlas, so the overlay doesn't
+ * allocate once its glyphs are cached. When HANDCRANK_ENGINE_DEBUG is
+ * defined it is only drawn while debug is toggled on.
+ */
+class DebugOverlay : public TextRenderObject
+{
+  protected:
+    std::array<char, DEBUG_OVERLAY_TEXT_CAPACITY> overlayText{};
+
+    size_t overlayTextLength = 0;
+
+    double refreshInterval = DEFAULT_DEBUG_OVERLAY_REFRESH_INTERVAL;
+
+    double timeSinceRefresh = DEFAULT_DEBUG_OVERLAY_REFRESH_INTERVAL;
+
+    MemoryReport memoryReport;
+
+    /**
+     * Append a formatted line to the overlay text.
+     *
+     * @param format printf style format string.
+     */
+    void AppendLine(const char *format, ...)
+    {
+        if (overlayTextLength >= overlayText.size())
+        {
+            return;
+        }
+
+        va_list args;
+
+        va_start(args, format);
+
+        auto written = std::vsnprintf(&overlayText[overlayTextLength],
+                                      overlayText.size() - overlayTextLength,
+                                      format, args);
+
+        va_end(args);
+
+        if (written < 0)
+        {
+            return;
+        }
+
+        overlayTextLength =
+            std::min(overlayTextLength + static_cast<size_t>(written),
+                     overlayText.size() - 1);
+
+        if (overlayTextLength + 1 < overlayText.size())
+        {
+            overlayText[overlayTextLength] = '\n';
+            overlayText[overlayTextLength + 1] = '\0';
+
+            overlayTextLength += 1;
+        }
+    }
+
+    /**
+     * Fill the overlay text. Override to add lines of your own after calling
+     * this.
+     */
+    virtual void BuildText()
+    {
+        AppendLine("FPS %.0f", game->GetFPS());
+
+        game->GetMemoryReport(memoryReport);
+
+        AppendLine("Memory %.1f MB",
+                   memoryReport.GetTotalBytes() / BYTES_PER_MEGABYTE);
+        AppendLine("  Textures %zu (%.1f MB), atlas pages %zu (%.1f MB)",
+                   memoryReport.textureCacheCount,
+                   memoryReport.textureCacheBytes / BYTES_PER_MEGABYTE,
+                   memoryReport.textureAtlasPageCount,
+                   memoryReport.textureAtlasBytes / BYTES_PER_MEGABYTE);
+        AppendLine("  Fonts %zu (%.1f MB), glyph pages %zu (%.1f MB)",
+                   memoryReport.fontCacheCount,
+                   memoryReport.fontCacheBytes / BYTES_PER_MEGABYTE,
+                   memoryReport.glyphAtlasPageCount,
+                   memoryReport.glyphAtlasBytes / BYTES_PER_MEGABYTE);
+        AppendLine("  Sounds %zu (%.1f MB), music %zu (%.1f MB)",
+                   memoryReport.audioSFXCacheCount,
+                   memoryReport.audioSFXCacheBytes / BYTES_PER_MEGABYTE,
+                   memoryReport.audioMusicCacheCount,
+                   memoryReport.audioMusicCacheBytes / BYTES_PER_MEGABYTE);
+        AppendLine("  Objects %zu (%.1f MB), frame arena %.1f MB",
+                   memoryReport.objectCount,
+                   (memoryReport.objectInstanceBytes +
+                    memoryReport.objectResourceBytes) /
+                       BYTES_PER_MEGABYTE,
+                   memoryReport.frameArenaBytes / BYTES_PER_MEGABYTE);
+
+#ifdef HANDCRANK_ENGINE_DEBUG
+        const auto &renderStats = game->GetRenderStats();
+
+        AppendLine("Render calls %u", renderStats.renderCalls);
+        AppendLine("Texture binds %u", renderStats.textureBinds);
+        AppendLine("State changes %u", renderStats.stateChanges);
+        AppendLine("Objects visited %u, culled %u", renderStats.objectsVisited,
+                   renderStats.objectsCulled);
+#endif
+
+#ifdef HANDCRANK_ENGINE_TRACK_ALLOCATIONS
+        const auto &tracker = AllocationTracker::Get();
+
+        auto frameStats = tracker.GetFrameStats();
+
+        AppendLine("Allocations %llu (%llu bytes)",
+                   static_cast<unsigned long long>(frameStats.count),
+                   static_cast<unsigned long long>(frameStats.bytes));
+
+        for (size_t i = 0; i < ALLOCATION_PHASE_COUNT; i += 1)
+        {
+            auto phase = static_cast<AllocationPhase>(i);
+
+            auto stats = tracker.GetFrameStats(phase);
+
+            if (stats.count > 0)
+            {
+                AppendLine("  %s %llu (%llu bytes)",
+                           GetAllocationPhaseName(phase),
+                           static_cast<unsigned long long>(stats.count),
+                           static_cast<unsigned long long>(stats.bytes));
+            }
+        }
+#endif
+    }
+
+  public:
+    using TextRenderObject::TextRenderObject;
+
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(DebugOverlay);
+    }
+
+    /**
+     * Set how often the overlay text is rebuilt.
+     *
+     * @param refreshInterval Interval in seconds.
+     */
+    void SetRefreshInterval(double refreshInterval)
+    {
+        this->refreshInterval = refreshInterval;
+    }
+
+    void Start() override
+    {
+        EnableGlyphAtlas();
+
+        SetZ(INT_MAX);
+    }
+
+    void Update(double deltaTime) override
+    {
+        timeSinceRefresh += deltaTime;
+
+        if (timeSinceRefresh < refreshInterval)
+        {
+            return;
+        }
+
+        timeSinceRefresh = 0;
+
+        overlayTextLength = 0;
+        overlayText[0] = '\0';
+
+        BuildText();
+
+        SetRect(GetRect().x, GetRect().y, static_cast<float>(game->GetWidth()),
+                GetRect().h);
+
+        SetWrappedText(overlayText.data());
+    }
+
+    void Render(SDL_Renderer *renderer) override
+    {
+#ifdef HANDCRANK_ENGINE_DEBUG
+        if (!game->IsDebug())
+        {
+            return;
+        }
+#endif
+
+        TextRenderObject::Render(renderer);
+    }
+};
+
+} // namespace HandcrankEngine
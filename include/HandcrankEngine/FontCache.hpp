@@ -12,6 +12,8 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 
+#include "GlyphAtlas.hpp"
+#include "ResourceCache.hpp"
 #include "Utilities.hpp"
 
 namespace HandcrankEngine
@@ -23,8 +25,7 @@ namespace
 {
 bool fontLoadedForFirstTime = false;
 
-inline std::unordered_map<std::size_t, std::shared_ptr<TTF_Font>> fontCache =
-    std::unordered_map<std::size_t, std::shared_ptr<TTF_Font>>();
+inline ResourceCache<TTF_Font> fontCache;
 } // namespace
 
 struct FontDeleter
@@ -33,12 +34,33 @@ struct FontDeleter
     {
         if (font != nullptr)
         {
+            RemoveCachedGlyphs(font);
+
             TTF_CloseFont(font);
         }
     }
 };
 
-inline auto ClearFontCache() -> void { fontCache.clear(); }
+inline auto ClearFontCache() -> void
+{
+    fontCache.Clear();
+
+    ClearGlyphAtlas();
+}
+
+/**
+ * Set the memory budget for cached fonts, estimated from the font file
+ * size. Least recently used fonts that are only referenced by the cache are
+ * closed once the budget is exceeded.
+ *
+ * @param bytes Budget in bytes, 0 for unlimited.
+ */
+inline void SetFontCacheBudget(size_t bytes) { fontCache.SetBudget(bytes); }
+
+[[nodiscard]] inline auto GetFontCacheSize() -> size_t
+{
+    return fontCache.GetTotalBytes();
+}
 
 inline auto CleanupFontInits() -> void
 {
@@ -54,17 +76,16 @@ inline auto CleanupFontInits() -> void
  * @param path File path to font file.
  * @param ptSize The size of the font.
  */
-inline auto LoadCachedFont(const char *path, int ptSize = DEFAULT_FONT_SIZE)
-    -> TTF_Font *
+inline auto LoadCachedSharedFont(const char *path,
+                                 int ptSize = DEFAULT_FONT_SIZE)
+    -> std::shared_ptr<TTF_Font>
 {
     auto cacheKey = std::hash<std::string_view>{}(std::string_view(path)) ^
                     std::hash<int>{}(ptSize);
 
-    auto match = fontCache.find(cacheKey);
-
-    if (match != fontCache.end())
+    if (auto font = fontCache.Find(cacheKey))
     {
-        return match->second.get();
+        return font;
     }
 
     if (!fontLoadedForFirstTime)
@@ -85,9 +106,9 @@ inline auto LoadCachedFont(const char *path, int ptSize = DEFAULT_FONT_SIZE)
         return nullptr;
     }
 
-    fontCache.insert_or_assign(cacheKey, font);
+    fontCache.Insert(cacheKey, font, GetFileSize(path));
 
-    return font.get();
+    return font;
 }
 
 /**
@@ -97,16 +118,15 @@ inline auto LoadCachedFont(const char *path, int ptSize = DEFAULT_FONT_SIZE)
  * @param size The buffer size, in bytes.
  * @param ptSize The size of the font.
  */
-inline auto LoadCachedFont(const void *mem, int size,
-                           int ptSize = DEFAULT_FONT_SIZE) -> TTF_Font *
+inline auto LoadCachedSharedFont(const void *mem, int size,
+                                 int ptSize = DEFAULT_FONT_SIZE)
+    -> std::shared_ptr<TTF_Font>
 {
     auto cacheKey = MemHash(mem, size) ^ std::hash<int>{}(ptSize);
 
-    auto match = fontCache.find(cacheKey);
-
-    if (match != fontCache.end())
+    if (auto font = fontCache.Find(cacheKey))
     {
-        return match->second.get();
+        return font;
     }
 
     if (!fontLoadedForFirstTime)
@@ -136,7 +156,42 @@ inline auto LoadCachedFont(const void *mem, int size,
         return nullptr;
     }
 
-    fontCache.insert_or_assign(cacheKey, font);
+    fontCache.Insert(cacheKey, font, size);
+
+    return font;
+}
+
+/**
+ * Load font from a path. The cache keeps ownership of the font and never
+ * evicts it, use LoadCachedSharedFont for fonts that can be evicted once
+ * unused when a cache budget is set.
+ *
+ * @param path File path to font file.
+ * @param ptSize The size of the font.
+ */
+inline auto LoadCachedFont(const char *path, int ptSize = DEFAULT_FONT_SIZE)
+    -> TTF_Font *
+{
+    auto font = LoadCachedSharedFont(path, ptSize);
+
+    fontCache.Pin(font);
+
+    return font.get();
+}
+
+/**
+ * Load font from a read-only buffer.
+ *
+ * @param mem A pointer to a read-only buffer.
+ * @param size The buffer size, in bytes.
+ * @param ptSize The size of the font.
+ */
+inline auto LoadCachedFont(const void *mem, int size,
+                           int ptSize = DEFAULT_FONT_SIZE) -> TTF_Font *
+{
+    auto font = LoadCachedSharedFont(mem, size, ptSize);
+
+    fontCache.Pin(font);
 
     return font.get();
 }
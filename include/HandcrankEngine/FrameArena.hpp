@@ -0,0 +1,167 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace HandcrankEngine
+{
+
+inline const size_t DEFAULT_FRAME_ARENA_BLOCK_SIZE = 64 * 1024;
+
+/**
+ * Bump allocator for memory that only lives until the end of a frame.
+ * Allocating moves a pointer forward, deallocating does nothing and Reset
+ * frees everything at once. When a frame needs more than the current block
+ * another block is added, and on the next Reset the blocks are merged into
+ * one big enough for the whole frame, so steady state frames don't touch the
+ * global heap.
+ *
+ * Use it through std::pmr containers. It is not thread safe and anything
+ * allocated from it must not be used after the frame it was allocated in.
+ */
+class FrameArena : public std::pmr::memory_resource
+{
+  private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> data;
+
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+
+    size_t blockSize = DEFAULT_FRAME_ARENA_BLOCK_SIZE;
+
+    size_t offset = 0;
+
+    size_t usedBytes = 0;
+
+    size_t peakBytes = 0;
+
+    void AddBlock(size_t size)
+    {
+        blocks.push_back({std::make_unique<std::byte[]>(size), size});
+
+        offset = 0;
+    }
+
+  protected:
+    auto do_allocate(size_t bytes, size_t alignment) -> void * override
+    {
+        if (blocks.empty())
+        {
+            AddBlock(std::max(blockSize, bytes + alignment));
+        }
+
+        auto &block = blocks.back();
+
+        auto base = reinterpret_cast<uintptr_t>(block.data.get());
+
+        auto aligned = (base + offset + alignment - 1) & ~(alignment - 1);
+
+        if (aligned + bytes > base + block.size)
+        {
+            AddBlock(std::max(blockSize, bytes + alignment));
+
+            return do_allocate(bytes, alignment);
+        }
+
+        usedBytes += aligned + bytes - (base + offset);
+
+        offset = aligned + bytes - base;
+
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    void do_deallocate(void *pointer, size_t bytes, size_t alignment) override
+    {
+    }
+
+    [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource &other) const
+        noexcept -> bool override
+    {
+        return this == &other;
+    }
+
+  public:
+    FrameArena() = default;
+
+    /**
+     * Create an arena.
+     *
+     * @param blockSize Size in bytes of the first block, and of any block
+     * added when a frame runs out of room.
+     */
+    explicit FrameArena(size_t blockSize) : blockSize(blockSize) {}
+
+    FrameArena(const FrameArena &) = delete;
+    auto operator=(const FrameArena &) -> FrameArena & = delete;
+
+    /**
+     * Free everything allocated since the last reset. If the frame needed
+     * more than one block, they are replaced with a single block big enough
+     * for it.
+     */
+    void Reset()
+    {
+        peakBytes = std::max(peakBytes, usedBytes);
+
+        if (blocks.size() > 1)
+        {
+            size_t totalSize = 0;
+
+            for (const auto &block : blocks)
+            {
+                totalSize += block.size;
+            }
+
+            blocks.clear();
+
+            AddBlock(totalSize);
+        }
+
+        offset = 0;
+
+        usedBytes = 0;
+    }
+
+    [[nodiscard]] auto GetUsedBytes() const -> size_t { return usedBytes; }
+
+    [[nodiscard]] auto GetPeakBytes() const -> size_t
+    {
+        return std::max(peakBytes, usedBytes);
+    }
+
+    [[nodiscard]] auto GetCapacity() const -> size_t
+    {
+        size_t capacity = 0;
+
+        for (const auto &block : blocks)
+        {
+            capacity += block.size;
+        }
+
+        return capacity;
+    }
+
+    [[nodiscard]] auto GetBlockCount() const -> size_t
+    {
+        return blocks.size();
+    }
+};
+
+} // namespace HandcrankEngine
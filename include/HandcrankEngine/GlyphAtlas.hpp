@@ -0,0 +1,172 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+#include "TextureAtlas.hpp"
+
+namespace HandcrankEngine
+{
+
+inline const int DEFAULT_GLYPH_ATLAS_PAGE_SIZE = 1024;
+
+/**
+ * A single rasterized glyph. The region is rendered in white so it can be
+ * tinted with vertex colors, and is positioned relative to the pen position
+ * at the top of the line.
+ */
+struct Glyph
+{
+    std::shared_ptr<TextureAtlasRegion> region;
+
+    int offsetX = 0;
+};
+
+/**
+ * Rasterizes glyphs once per font into shared atlas pages so text can be
+ * drawn as textured quads instead of a texture per string.
+ */
+class GlyphAtlas
+{
+  private:
+    TextureAtlas atlas;
+
+    std::unordered_map<TTF_Font *, std::unordered_map<Uint32, Glyph>> fonts;
+
+  public:
+    explicit GlyphAtlas(SDL_Renderer *renderer,
+                        int pageSize = DEFAULT_GLYPH_ATLAS_PAGE_SIZE)
+        : atlas(renderer, pageSize)
+    {
+    }
+
+    [[nodiscard]] auto GetRenderer() const -> SDL_Renderer *
+    {
+        return atlas.GetRenderer();
+    }
+
+    [[nodiscard]] auto GetPageCount() const -> size_t
+    {
+        return atlas.GetPageCount();
+    }
+
+    [[nodiscard]] auto GetByteSize() const -> size_t
+    {
+        return atlas.GetByteSize();
+    }
+
+    /**
+     * Check if a glyph has already been rasterized, or found to be missing
+     * from the font, so getting it won't touch the atlas.
+     *
+     * @param font Font to rasterize with.
+     * @param codepoint Character to rasterize.
+     */
+    [[nodiscard]] auto HasGlyph(TTF_Font *font, Uint32 codepoint) const -> bool
+    {
+        auto match = fonts.find(font);
+
+        return match != fonts.end() && match->second.count(codepoint) > 0;
+    }
+
+    /**
+     * Get a glyph, rasterizing it into the atlas the first time it is used.
+     * Returns nullptr for glyphs the font can't render.
+     *
+     * @param font Font to rasterize with.
+     * @param codepoint Character to rasterize.
+     */
+    auto GetGlyph(TTF_Font *font, Uint32 codepoint) -> const Glyph *
+    {
+        auto &glyphs = fonts[font];
+
+        auto match = glyphs.find(codepoint);
+
+        if (match != glyphs.end())
+        {
+            return match->second.region != nullptr ? &match->second : nullptr;
+        }
+
+        auto &glyph = glyphs[codepoint];
+
+        auto *surface =
+            TTF_RenderGlyph32_Blended(font, codepoint,
+                                      {SDL_ALPHA_OPAQUE, SDL_ALPHA_OPAQUE,
+                                       SDL_ALPHA_OPAQUE, SDL_ALPHA_OPAQUE});
+
+        if (surface == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto minX = 0;
+
+        TTF_GlyphMetrics32(font, codepoint, &minX, nullptr, nullptr, nullptr,
+                           nullptr);
+
+        glyph.region = atlas.Add(surface);
+        glyph.offsetX = std::min(minX, 0);
+
+        SDL_FreeSurface(surface);
+
+        return glyph.region != nullptr ? &glyph : nullptr;
+    }
+
+    /**
+     * Forget the glyphs of a font. Must be called before the font is closed.
+     *
+     * @param font Font to forget.
+     */
+    void RemoveFont(TTF_Font *font) { fonts.erase(font); }
+};
+
+namespace
+{
+inline std::unique_ptr<GlyphAtlas> glyphAtlas;
+} // namespace
+
+/**
+ * Get the glyph atlas for a renderer, creating it if needed.
+ *
+ * @param renderer A structure representing rendering state.
+ */
+[[nodiscard]] inline auto GetGlyphAtlas(SDL_Renderer *renderer) -> GlyphAtlas &
+{
+    if (!glyphAtlas || glyphAtlas->GetRenderer() != renderer)
+    {
+        glyphAtlas = std::make_unique<GlyphAtlas>(renderer);
+    }
+
+    return *glyphAtlas;
+}
+
+/**
+ * Forget the cached glyphs of a font. Fonts loaded through the font cache do
+ * this automatically when they are closed.
+ *
+ * @param font Font to forget.
+ */
+inline void RemoveCachedGlyphs(TTF_Font *font)
+{
+    if (glyphAtlas)
+    {
+        glyphAtlas->RemoveFont(font);
+    }
+}
+
+inline void ClearGlyphAtlas() { glyphAtlas.reset(); }
+
+} // namespace HandcrankEngine
@@ -19,16 +19,35 @@
 #define HANDCRANK_ENGINE_VERSION_MINOR 0
 #define HANDCRANK_ENGINE_VERSION_PATCH 0
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
 
 #include <SDL.h>
 #include <SDL_ttf.h>
 
+#include "AllocationTracker.hpp"
+#include "AnimationScheduler.hpp"
 #include "AudioCache.hpp"
 #include "FontCache.hpp"
 #include "TextureCache.hpp"
 
+#include "FrameArena.hpp"
 #include "InputHandler.hpp"
+#include "JobSystem.hpp"
+#include "MemoryReport.hpp"
+#include "Profiler.hpp"
+#include "RenderBatch.hpp"
+#include "RenderObjectPool.hpp"
+#include "RenderObjectView.hpp"
+#include "RenderStats.hpp"
+#include "SpatialHash.hpp"
+#include "Tween.hpp"
 #include "Utilities.hpp"
 #include "Vector2.hpp"
 
@@ -50,9 +69,18 @@ inline const int DEFAULT_WINDOW_HEIGHT = 600;
 inline const float DEFAULT_RECT_WIDTH = 100;
 inline const float DEFAULT_RECT_HEIGHT = 100;
 
+inline const char *const HEADLESS_ENVIRONMENT_VARIABLE =
+    "HANDCRANK_ENGINE_HEADLESS";
+
 class Game;
 class RenderObject;
 
+enum class GameMode : uint8_t
+{
+    WINDOWED,
+    HEADLESS
+};
+
 enum class RectAnchor : uint8_t
 {
     TOP = 0x01,
@@ -83,11 +111,20 @@ class Game : public InputHandler
     SDL_Window *window = nullptr;
     SDL_Renderer *renderer = nullptr;
 
+    SDL_Surface *headlessSurface = nullptr;
+    SDL_Texture *headlessTarget = nullptr;
+
+    bool headless = false;
+
     SDL_Rect viewport{};
     SDL_FRect viewportf{};
 
     SDL_Color clearColor{0, 0, 0, MAX_ALPHA};
 
+    RenderBatch renderBatch;
+
+    bool isRenderBatchingEnabled = false;
+
     bool quit = false;
 
     bool fullscreen = false;
@@ -95,12 +132,65 @@ class Game : public InputHandler
     std::vector<std::shared_ptr<RenderObject>> children;
     std::vector<std::shared_ptr<RenderObject>> childrenBuffer;
 
+    bool childrenBufferIsDirty = true;
+    bool descendantChildrenBufferIsDirty = false;
+
+    std::vector<RenderObject *> renderOrderBuffer;
+
+    bool renderOrderIsDirty = true;
+
+    bool descendantIsMarkedForDestroy = false;
+
     std::vector<std::shared_ptr<RenderObject>> colliders;
+    std::vector<std::shared_ptr<RenderObject>> pendingColliders;
+    std::vector<RenderObject *> dirtyColliders;
+
+    std::unordered_map<const RenderObject *, size_t> colliderProxies;
+
+    SpatialHash colliderSpatialHash;
+
+    FrameArena frameArena;
+
+    AnimationScheduler animationScheduler;
+
+    TweenSystem tweens{this};
+
+    std::unique_ptr<JobSystem> jobSystem;
+
+    size_t jobThreadCount = 0;
+
+    bool isParallelUpdateEnabled = false;
+    bool isUpdatingInParallel = false;
+
+    std::vector<RenderObject *> independentObjects;
+
+    std::vector<std::function<void()>> deferredCommands;
+
+    std::mutex parallelUpdateMutex;
+
+    struct TypeIndexEntry
+    {
+        bool (*matches)(const RenderObject *);
+
+        std::vector<RenderObject *> objects;
+    };
+
+    std::vector<RenderObject *> registeredObjects;
+
+    std::unordered_map<std::type_index, TypeIndexEntry> typeIndex;
+
+    std::unordered_map<std::string, std::vector<RenderObject *>> tagIndex;
+
+    std::vector<std::shared_ptr<RenderObject>> pointerHits;
+    std::vector<std::weak_ptr<RenderObject>> hoveredObjects;
+    std::vector<std::weak_ptr<RenderObject>> activeObjects;
 
     double elapsedTime = 0;
     double deltaTime = 0;
     double fixedUpdateDeltaTime = 0;
 
+    double fixedDeltaTime = 0;
+
     double frameRate = DEFAULT_FRAME_RATE;
 
     Uint64 previousFrameStart = 0;
@@ -120,6 +210,7 @@ class Game : public InputHandler
 
   public:
     inline Game();
+    inline explicit Game(GameMode mode);
     virtual inline ~Game();
 
     inline void AddChildObject(const std::shared_ptr<RenderObject> &child);
@@ -130,19 +221,75 @@ class Game : public InputHandler
     template <typename T>
     [[nodiscard]] inline auto GetChildByType(bool nested = false)
         -> std::shared_ptr<T>;
+    template <typename T, typename Allocator>
+    inline void
+    CollectChildrenByType(std::vector<std::shared_ptr<T>, Allocator> &results,
+                          bool nested = false);
     [[nodiscard]] inline auto GetChildCount() -> int;
 
+    template <typename T>
+    [[nodiscard]] inline auto GetObjectsByType() -> RenderObjectView<T>;
+    [[nodiscard]] inline auto GetObjectsByTag(const std::string &tag)
+        -> RenderObjectView<RenderObject>;
+
+    inline void RegisterObject(RenderObject *object);
+    inline void UpdateObjectTag(RenderObject *object,
+                                const std::string &previousTag);
+    inline void UnregisterDestroyedObjects();
+
     inline void AddCollider(const std::shared_ptr<RenderObject> &collider);
+    inline void SetColliderAsDirty(RenderObject *collider);
+    inline void RemoveCollider(const RenderObject *collider);
+
+    [[nodiscard]] inline auto GetCollisionCellSize() const -> float;
+    inline void SetCollisionCellSize(float cellSize);
+
+    [[nodiscard]] inline auto GetFrameArena() -> FrameArena &;
+    [[nodiscard]] inline auto GetFrameMemoryResource()
+        -> std::pmr::memory_resource *;
+
+    [[nodiscard]] inline auto GetAnimationScheduler() -> AnimationScheduler &;
+
+    [[nodiscard]] inline auto GetTweens() -> TweenSystem &;
+
+    inline void GetMemoryReport(MemoryReport &report) const;
+    [[nodiscard]] inline auto GetMemoryReport() const -> MemoryReport;
+    inline auto DumpMemoryReport(
+        const std::string &path = DEFAULT_MEMORY_REPORT_OUTPUT_PATH) const
+        -> bool;
+
+    [[nodiscard]] inline auto GetJobSystem() -> JobSystem &;
+    inline void SetJobThreadCount(size_t threadCount);
+
+    inline void EnableParallelUpdate();
+    inline void DisableParallelUpdate();
+    [[nodiscard]] inline auto IsParallelUpdateEnabled() const -> bool;
+    [[nodiscard]] inline auto IsUpdatingInParallel() const -> bool;
+
+    inline void Defer(std::function<void()> command);
+    inline void RunDeferredCommands();
+
+    inline void AddIndependentObject(RenderObject *object);
 
     [[nodiscard]] inline auto GetWindow() -> SDL_Window *;
     [[nodiscard]] inline auto GetRenderer() -> SDL_Renderer *;
     [[nodiscard]] inline auto GetViewport() const -> const SDL_FRect &;
 
+    inline void EnableRenderBatching();
+    inline void DisableRenderBatching();
+    [[nodiscard]] inline auto IsRenderBatchingEnabled() const -> bool;
+    [[nodiscard]] inline auto GetRenderBatch() -> RenderBatch &;
+    inline void FlushRenderBatch();
+
     inline auto SwitchToFullscreen() -> bool;
     inline auto SwitchToWindowedMode() -> bool;
     [[nodiscard]] inline auto IsFullscreen() const -> bool;
 
+    [[nodiscard]] inline auto IsHeadless() const -> bool;
+
     inline auto Setup() -> bool;
+    inline auto SetupHeadless() -> bool;
+    inline auto ResizeHeadlessTarget() -> bool;
 
     inline void SetScreenSize(int _width, int _height);
 
@@ -165,6 +312,10 @@ class Game : public InputHandler
 
     inline void SetFrameRate(double frameRate);
 
+    [[nodiscard]] inline auto GetFixedDeltaTime() const -> double;
+
+    inline void SetFixedDeltaTime(double fixedDeltaTime);
+
     [[nodiscard]] inline auto GetQuit() const -> bool;
 
     [[nodiscard]] inline auto Run() -> int;
@@ -177,25 +328,44 @@ class Game : public InputHandler
 
     inline void HandleInput();
 
+    inline void HandleEvent();
+
     inline void CalculateDeltaTime();
 
     inline void PopulateChildrenBuffer();
 
+    inline void SetChildrenBufferAsDirty();
+    inline void SetDescendantChildrenBufferAsDirty();
+
+    inline void SetRenderOrderAsDirty();
+
+    [[nodiscard]] inline auto GetRenderOrderBuffer()
+        -> const std::vector<RenderObject *> &;
+
+    inline void DispatchPointerEvents();
+
     inline void Update();
     inline void FixedUpdate();
 
+    inline void ParallelUpdate(void (RenderObject::*update)(double),
+                               double deltaTime);
+
     inline void Render();
 
     inline void ResolveCollisions();
 
     inline void DestroyChildObjects();
 
+    inline void SetDescendantAsMarkedForDestroy();
+
     inline void Quit();
 
 #ifdef HANDCRANK_ENGINE_DEBUG
     inline void ToggleDebug(bool state);
     inline void ToggleDebug();
     [[nodiscard]] inline auto IsDebug() const -> bool;
+
+    [[nodiscard]] inline auto GetRenderStats() const -> const RenderStats &;
 #endif
 };
 
@@ -208,10 +378,10 @@ class RenderObject : public std::enable_shared_from_this<RenderObject>
     mutable bool transformedRectIsDirty = true;
 
     mutable SDL_FRect boundingBox = SDL_FRect();
-    mutable bool boundingBoxIsDirty = true;
+    mutable std::atomic<bool> boundingBoxIsDirty{true};
 
   protected:
-    inline static unsigned int count = 0;
+    inline static std::atomic<unsigned int> count{0};
 
     int index = -1;
 
@@ -231,19 +401,39 @@ class RenderObject : public std::enable_shared_from_this<RenderObject>
 
     bool isMarkedForDestroy = false;
 
+    bool isIndependent = false;
+
+    bool isRegistered = false;
+
+    RenderObjectPoolBase *pool = nullptr;
+
+    bool isPointerEventsEnabled = false;
+
+    mutable bool hasPointerEventsInSubtree = false;
+    mutable bool pointerEventsInSubtreeIsDirty = true;
+
     bool isInputHovered = false;
     bool isInputActive = false;
 
     std::vector<std::shared_ptr<RenderObject>> children;
     std::vector<std::shared_ptr<RenderObject>> childrenBuffer;
 
+    bool childrenBufferIsDirty = true;
+    bool descendantChildrenBufferIsDirty = false;
+
+    std::vector<RenderObject *> renderOrderBuffer;
+
+    bool renderOrderIsDirty = true;
+
+    bool descendantIsMarkedForDestroy = false;
+
+    int z = 0;
+
   public:
     Game *game = nullptr;
 
     RenderObject *parent = nullptr;
 
-    int z = 0;
-
     inline RenderObject();
     inline RenderObject(Vector2 position);
     inline RenderObject(float x, float y);
@@ -254,9 +444,22 @@ class RenderObject : public std::enable_shared_from_this<RenderObject>
     inline void Enable();
     inline void Disable();
     [[nodiscard]] inline auto IsEnabled() const -> bool;
+    [[nodiscard]] inline auto IsEnabledInHierarchy() const -> bool;
 
     [[nodiscard]] inline auto IsCollisionEnabled() const -> bool;
 
+    [[nodiscard]] inline auto IsIndependent() const -> bool;
+    inline void SetIsIndependent(bool isIndependent);
+
+    [[nodiscard]] inline auto IsRegistered() const -> bool;
+    inline void SetIsRegistered(bool isRegistered);
+
+    [[nodiscard]] inline auto GetPool() const -> RenderObjectPoolBase *;
+    inline void SetPool(RenderObjectPoolBase *pool);
+
+    inline void ResetForReuse();
+    inline void ReturnToPool();
+
     [[nodiscard]] inline auto GetIndex() const -> int;
 
     [[nodiscard]] inline auto GetName() const -> std::string;
@@ -267,6 +470,9 @@ class RenderObject : public std::enable_shared_from_this<RenderObject>
 
     [[nodiscard]] inline auto GetClassName() const -> std::string;
 
+    [[nodiscard]] virtual inline auto GetInstanceSize() const -> size_t;
+    [[nodiscard]] virtual inline auto GetResourceBytes() const -> size_t;
+
     [[nodiscard]] inline auto ShowInHierarchy() const -> std::string;
 
     inline void AddChildObject(const std::shared_ptr<RenderObject> &child);
@@ -277,14 +483,50 @@ class RenderObject : public std::enable_shared_from_this<RenderObject>
     template <typename T>
     [[nodiscard]] inline auto GetChildByType(bool nested = false)
         -> std::shared_ptr<T>;
+    template <typename T, typename Allocator>
+    inline void
+    CollectChildrenByType(std::vector<std::shared_ptr<T>, Allocator> &results,
+                          bool nested = false);
     [[nodiscard]] inline auto GetChildCount() -> int;
 
     inline void PopulateChildrenBuffer();
 
+    inline void SetChildrenBufferAsDirty();
+    inline void SetDescendantChildrenBufferAsDirty();
+
+    [[nodiscard]] inline auto GetZ() const -> int;
+    inline void SetZ(int z);
+
+    inline void SetRenderOrderAsDirty();
+
+    [[nodiscard]] inline auto GetRenderOrderBuffer()
+        -> const std::vector<RenderObject *> &;
+
+    inline void EnablePointerEvents();
+    inline void DisablePointerEvents();
+    [[nodiscard]] inline auto IsPointerEventsEnabled() const -> bool;
+
+    [[nodiscard]] inline auto HasPointerEventsInSubtree() const -> bool;
+    inline void SetPointerEventsInSubtreeAsDirty();
+
+    inline void CollectPointerHits(
+        const SDL_FPoint &point,
+        std::vector<std::shared_ptr<RenderObject>> &hits);
+
+    [[nodiscard]] inline auto IsInputHovered() const -> bool;
+    [[nodiscard]] inline auto IsInputActive() const -> bool;
+
+    inline auto DispatchPointerOver(bool isPressed) -> bool;
+    inline void DispatchPointerOut();
+    inline void DispatchPointerUp();
+
     virtual inline void Start();
     virtual inline void Update(double deltaTime);
     virtual inline void FixedUpdate(double deltaTime);
 
+    // Pointer callbacks are opt-in and only called once EnablePointerEvents
+    // has been called, so objects that override them must enable pointer
+    // events, for example in Start.
     virtual inline void OnMouseOver();
     virtual inline void OnMouseOut();
     virtual inline void OnMouseDown();
@@ -296,6 +538,7 @@ class RenderObject : public std::enable_shared_from_this<RenderObject>
     virtual inline void InternalFixedUpdate(double fixedDeltaTime);
 
     virtual inline void OnDestroy();
+    virtual inline void OnReuse();
 
     [[nodiscard]] inline auto GetRect() const -> const SDL_FRect &;
     inline void SetRect(const SDL_FRect &rect);
@@ -333,20 +576,86 @@ class RenderObject : public std::enable_shared_from_this<RenderObject>
 
     [[nodiscard]] inline auto HasBeenMarkedForDestroy() const -> bool;
 
+    inline void SetDescendantAsMarkedForDestroy();
+
     inline void Destroy();
 };
 
-inline Game::Game() { Setup(); }
+/**
+ * Rebuild a z-sorted list of raw pointers into a children buffer. Children
+ * with the same z keep the order they were added in.
+ */
+inline void PopulateRenderOrderBuffer(
+    const std::vector<std::shared_ptr<RenderObject>> &childrenBuffer,
+    std::vector<RenderObject *> &renderOrderBuffer)
+{
+    renderOrderBuffer.clear();
+
+    for (const auto &child : childrenBuffer)
+    {
+        if (child != nullptr)
+        {
+            renderOrderBuffer.emplace_back(child.get());
+        }
+    }
+
+    std::stable_sort(renderOrderBuffer.begin(), renderOrderBuffer.end(),
+                     [](const RenderObject *a, const RenderObject *b)
+                     { return a->GetZ() < b->GetZ(); });
+}
+
+/**
+ * Create a windowed game, or a headless one when the
+ * HANDCRANK_ENGINE_HEADLESS environment variable is set to anything other
+ * than 0.
+ */
+inline Game::Game()
+    : Game(SDL_getenv(HEADLESS_ENVIRONMENT_VARIABLE) != nullptr &&
+                   SDL_strcmp(SDL_getenv(HEADLESS_ENVIRONMENT_VARIABLE),
+                              "0") != 0
+               ? GameMode::HEADLESS
+               : GameMode::WINDOWED)
+{
+}
+
+/**
+ * Create a game.
+ *
+ * @param mode GameMode::HEADLESS renders into an offscreen software surface
+ * without a window, never presents and runs the loop without vsync or frame
+ * delays.
+ */
+inline Game::Game(GameMode mode) : headless(mode == GameMode::HEADLESS)
+{
+    Setup();
+}
 
 inline Game::~Game()
 {
+    jobSystem.reset();
+
+    HANDCRANK_PROFILE_DUMP();
+
+    HANDCRANK_ALLOCATION_SUMMARY();
+
+    registeredObjects.clear();
+    typeIndex.clear();
+    tagIndex.clear();
+
     children.clear();
     childrenBuffer.clear();
     colliders.clear();
+    pendingColliders.clear();
+    dirtyColliders.clear();
 
     SDL_DestroyWindow(window);
     SDL_DestroyRenderer(renderer);
 
+    if (headlessSurface != nullptr)
+    {
+        SDL_FreeSurface(headlessSurface);
+    }
+
     ClearAudioCache();
 
     ClearFontCache();
@@ -361,7 +670,23 @@ inline void Game::AddChildObject(const std::shared_ptr<RenderObject> &child)
 {
     child->game = this;
 
+    if (isUpdatingInParallel)
+    {
+        Defer([this, child] { AddChildObject(child); });
+
+        return;
+    }
+
     children.emplace_back(child);
+
+    RegisterObject(child.get());
+
+    SetChildrenBufferAsDirty();
+
+    if (child->HasBeenMarkedForDestroy())
+    {
+        SetDescendantAsMarkedForDestroy();
+    }
 }
 
 template <typename T>
@@ -373,6 +698,27 @@ inline auto Game::GetChildrenByType(bool nested)
 
     std::vector<std::shared_ptr<T>> results;
 
+    CollectChildrenByType(results, nested);
+
+    return results;
+}
+
+/**
+ * Append children of type T, or derived from it, to a vector. Pass a
+ * std::pmr::vector using GetFrameMemoryResource to collect into frame memory
+ * instead of the heap.
+ *
+ * @param results Vector to append to.
+ * @param nested Include descendants of children.
+ */
+template <typename T, typename Allocator>
+inline void
+Game::CollectChildrenByType(std::vector<std::shared_ptr<T>, Allocator> &results,
+                            bool nested)
+{
+    static_assert(std::is_base_of_v<RenderObject, T>,
+                  "T must be derived from RenderObject");
+
     for (const auto &child : childrenBuffer)
     {
         if (child == nullptr)
@@ -387,14 +733,9 @@ inline auto Game::GetChildrenByType(bool nested)
 
         if (nested)
         {
-            auto childResults = child->GetChildrenByType<T>(nested);
-
-            results.insert(results.end(), childResults.begin(),
-                           childResults.end());
+            child->CollectChildrenByType(results, nested);
         }
     }
-
-    return results;
 }
 
 template <typename T>
@@ -403,10 +744,25 @@ inline auto Game::GetChildByType(bool nested) -> std::shared_ptr<T>
     static_assert(std::is_base_of_v<RenderObject, T>,
                   "T must be derived from RenderObject");
 
-    if (auto childrenBuffer = GetChildrenByType<T>(nested);
-        !childrenBuffer.empty())
+    for (const auto &child : childrenBuffer)
     {
-        return childrenBuffer.front();
+        if (child == nullptr)
+        {
+            continue;
+        }
+
+        if (auto castedChild = std::dynamic_pointer_cast<T>(child))
+        {
+            return castedChild;
+        }
+
+        if (nested)
+        {
+            if (auto childResult = child->GetChildByType<T>(nested))
+            {
+                return childResult;
+            }
+        }
     }
 
     return nullptr;
@@ -414,134 +770,693 @@ inline auto Game::GetChildByType(bool nested) -> std::shared_ptr<T>
 
 inline auto Game::GetChildCount() -> int { return children.size(); }
 
-inline void Game::AddCollider(const std::shared_ptr<RenderObject> &collider)
+/**
+ * Get every object in the game of type T, or derived from it, in the order
+ * they were added. The first query for a type scans every object, after
+ * that the index is kept up to date as objects are added and destroyed.
+ */
+template <typename T>
+inline auto Game::GetObjectsByType() -> RenderObjectView<T>
 {
-    colliders.emplace_back(collider);
-}
+    static_assert(std::is_base_of_v<RenderObject, T>,
+                  "T must be derived from RenderObject");
 
-inline auto Game::GetWindow() -> SDL_Window * { return window; }
+    auto match = typeIndex.find(std::type_index(typeid(T)));
 
-inline auto Game::GetRenderer() -> SDL_Renderer * { return renderer; }
+    if (match == typeIndex.end())
+    {
+        TypeIndexEntry entry{
+            [](const RenderObject *object)
+            { return dynamic_cast<const T *>(object) != nullptr; },
+            {}};
 
-inline auto Game::GetViewport() const -> const SDL_FRect & { return viewportf; }
+        for (auto *object : registeredObjects)
+        {
+            if (entry.matches(object))
+            {
+                entry.objects.emplace_back(object);
+            }
+        }
 
-inline auto Game::SwitchToFullscreen() -> bool
+        match = typeIndex.emplace(std::type_index(typeid(T)), std::move(entry))
+                    .first;
+    }
+
+    return RenderObjectView<T>(match->second.objects);
+}
+
+/**
+ * Get every object in the game with a tag, in the order they were tagged.
+ * Objects without a tag are listed under "untagged".
+ *
+ * @param tag Tag to look up.
+ */
+inline auto Game::GetObjectsByTag(const std::string &tag)
+    -> RenderObjectView<RenderObject>
 {
-    auto result = SDL_SetWindowFullscreen(window, SDL_TRUE) == 0;
+    auto match = tagIndex.find(tag);
 
-    if (result)
+    if (match == tagIndex.end())
     {
-        fullscreen = true;
+        return {};
     }
 
-    return result;
+    return RenderObjectView<RenderObject>(match->second);
 }
 
-inline auto Game::SwitchToWindowedMode() -> bool
+/**
+ * Add an object to the type and tag indexes. Called when the object is added
+ * to the game or to an object in the game.
+ *
+ * @param object Object to add.
+ */
+inline void Game::RegisterObject(RenderObject *object)
 {
-    auto result = SDL_SetWindowFullscreen(window, SDL_FALSE) == 0;
-
-    if (result)
+    if (object->IsRegistered())
     {
-        SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED,
-                              SDL_WINDOWPOS_CENTERED);
+        return;
+    }
 
-        fullscreen = false;
+    object->SetIsRegistered(true);
+
+    registeredObjects.emplace_back(object);
+
+    for (auto &[type, entry] : typeIndex)
+    {
+        if (entry.matches(object))
+        {
+            entry.objects.emplace_back(object);
+        }
     }
 
-    return result;
+    tagIndex[object->GetTag()].emplace_back(object);
 }
 
-inline auto Game::IsFullscreen() const -> bool { return fullscreen; }
-
-inline auto Game::Setup() -> bool
+/**
+ * Move an object to the tag index entry of its current tag.
+ *
+ * @param object Object whose tag changed.
+ * @param previousTag Tag the object had before.
+ */
+inline void Game::UpdateObjectTag(RenderObject *object,
+                                  const std::string &previousTag)
 {
-    SDL_SetHint(SDL_HINT_WINDOWS_DPI_SCALING, "1");
-
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER) < 0)
+    if (!object->IsRegistered())
     {
-        return false;
+        return;
     }
 
-    if (window != nullptr)
+    if (auto match = tagIndex.find(previousTag); match != tagIndex.end())
     {
-        SDL_DestroyWindow(window);
-    }
+        auto &objects = match->second;
 
-#ifdef __EMSCRIPTEN__
-    window =
-        SDL_CreateWindow("", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-                         width, height, SDL_WINDOW_OPENGL);
-#else
-    window = SDL_CreateWindow("", SDL_WINDOWPOS_CENTERED,
-                              SDL_WINDOWPOS_CENTERED, width, height,
-                              SDL_WINDOW_OPENGL | SDL_WINDOW_ALLOW_HIGHDPI);
-#endif
+        objects.erase(std::remove(objects.begin(), objects.end(), object),
+                      objects.end());
+    }
 
-    SDL_SetWindowResizable(window, SDL_TRUE);
+    tagIndex[object->GetTag()].emplace_back(object);
+}
 
-    if (window == nullptr)
+/**
+ * Remove objects marked for destroy from the type and tag indexes. Called
+ * before destroyed objects are released.
+ */
+inline void Game::UnregisterDestroyedObjects()
+{
+    auto isDestroyed = [](RenderObject *object)
     {
-        SDL_Log("SDL_CreateWindow %s", SDL_GetError());
+        if (object->HasBeenMarkedForDestroy())
+        {
+            object->SetIsRegistered(false);
+
+            return true;
+        }
 
         return false;
-    }
+    };
 
-    if (renderer != nullptr)
+    auto wasRegistered = [](RenderObject *object)
+    { return !object->IsRegistered(); };
+
+    registeredObjects.erase(std::remove_if(registeredObjects.begin(),
+                                           registeredObjects.end(),
+                                           isDestroyed),
+                            registeredObjects.end());
+
+    for (auto &[type, entry] : typeIndex)
     {
-        SDL_DestroyRenderer(renderer);
+        entry.objects.erase(std::remove_if(entry.objects.begin(),
+                                           entry.objects.end(), wasRegistered),
+                            entry.objects.end());
     }
 
-    renderer = SDL_CreateRenderer(
-        window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    for (auto &[tag, objects] : tagIndex)
+    {
+        objects.erase(
+            std::remove_if(objects.begin(), objects.end(), wasRegistered),
+            objects.end());
+    }
+}
 
-    if (renderer == nullptr)
+inline void Game::AddCollider(const std::shared_ptr<RenderObject> &collider)
+{
+    if (isUpdatingInParallel)
     {
-        SDL_Log("SDL_CreateRenderer %s", SDL_GetError());
+        Defer([this, collider] { AddCollider(collider); });
 
-        return false;
+        return;
     }
 
-    SetScreenSize(width, height);
+    pendingColliders.emplace_back(collider);
+}
 
-    return true;
+inline void Game::SetColliderAsDirty(RenderObject *collider)
+{
+    if (isUpdatingInParallel)
+    {
+        std::lock_guard<std::mutex> lock(parallelUpdateMutex);
+
+        dirtyColliders.emplace_back(collider);
+
+        return;
+    }
+
+    dirtyColliders.emplace_back(collider);
 }
 
-inline void Game::SetScreenSize(int _width, int _height)
+/**
+ * Remove a collider from the broadphase now instead of on the next
+ * ResolveCollisions, along with any pending add or update.
+ *
+ * @param collider Collider to remove.
+ */
+inline void Game::RemoveCollider(const RenderObject *collider)
 {
-    SDL_SetWindowMinimumSize(window, _width, _height);
+    auto isCollider = [collider](const auto &pending)
+    { return pending.get() == collider; };
 
-    SDL_SetWindowSize(window, _width, _height);
+    pendingColliders.erase(std::remove_if(pendingColliders.begin(),
+                                          pendingColliders.end(), isCollider),
+                           pendingColliders.end());
 
-    SDL_GL_GetDrawableSize(window, &width, &height);
+    dirtyColliders.erase(
+        std::remove(dirtyColliders.begin(), dirtyColliders.end(), collider),
+        dirtyColliders.end());
 
-    viewport.w = width;
-    viewport.h = height;
-    viewportf.w = static_cast<float>(viewport.w);
-    viewportf.h = static_cast<float>(viewport.h);
+    auto match = colliderProxies.find(collider);
 
-    SDL_RenderSetScale(renderer, 1.0F, 1.0F);
-    SDL_RenderSetLogicalSize(renderer, width, height);
+    if (match == colliderProxies.end())
+    {
+        return;
+    }
 
-    SDL_RenderSetViewport(renderer, &viewport);
+    colliderSpatialHash.Remove(match->second);
 
-    SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED,
-                          SDL_WINDOWPOS_CENTERED);
+    colliders[match->second] = nullptr;
+
+    colliderProxies.erase(match);
 }
 
-inline void Game::RecalculateScreenSize()
+inline auto Game::GetCollisionCellSize() const -> float
 {
-    SDL_GL_GetDrawableSize(window, &width, &height);
+    return colliderSpatialHash.GetCellSize();
 }
 
-inline void Game::SetTitle(const char *name)
+inline void Game::SetCollisionCellSize(float cellSize)
 {
-    SDL_SetWindowTitle(window, name);
+    colliderSpatialHash.SetCellSize(cellSize);
 }
 
-inline void Game::SetClearColor(const SDL_Color color)
+/**
+ * Get the arena for memory that only lives until the end of the frame. It is
+ * reset at the start of every Game::Loop and must only be used from the main
+ * thread, so not from inside a parallel update.
+ */
+inline auto Game::GetFrameArena() -> FrameArena & { return frameArena; }
+
+/**
+ * Get the frame arena as a memory resource for std::pmr containers.
+ *
+ * @code
+ * std::pmr::vector<RenderObject *> nearby(game->GetFrameMemoryResource());
+ * @endcode
+ */
+inline auto Game::GetFrameMemoryResource() -> std::pmr::memory_resource *
 {
-    this->clearColor = color;
+    return &frameArena;
+}
+
+/**
+ * Get the scheduler that advances running animators once per frame after
+ * Update, while the game has focus.
+ */
+inline auto Game::GetAnimationScheduler() -> AnimationScheduler &
+{
+    return animationScheduler;
+}
+
+/**
+ * Get the tween system stepped once per frame after Update, while the game
+ * has focus.
+ *
+ * @code
+ * game->GetTweens().To(&alpha, 0, 0.5).Ease(Easing::EASE_OUT_QUAD);
+ * @endcode
+ */
+inline auto Game::GetTweens() -> TweenSystem & { return tweens; }
+
+/**
+ * Fill a report with the estimated memory held by the resource caches, the
+ * texture and glyph atlases, the frame arena and every object in the game.
+ * Reusing the same report keeps this from allocating once every class of
+ * object has been seen.
+ *
+ * @param report Report to fill.
+ */
+inline void Game::GetMemoryReport(MemoryReport &report) const
+{
+    report.Clear();
+
+    report.textureCacheCount = textureCache.GetCount();
+    report.textureCacheBytes = textureCache.GetTotalBytes();
+
+    if (textureAtlas)
+    {
+        report.textureAtlasPageCount = textureAtlas->GetPageCount();
+        report.textureAtlasBytes = textureAtlas->GetByteSize();
+    }
+
+    report.fontCacheCount = fontCache.GetCount();
+    report.fontCacheBytes = fontCache.GetTotalBytes();
+
+    if (glyphAtlas)
+    {
+        report.glyphAtlasPageCount = glyphAtlas->GetPageCount();
+        report.glyphAtlasBytes = glyphAtlas->GetByteSize();
+    }
+
+    report.audioSFXCacheCount = audioSFXCache.GetCount();
+    report.audioSFXCacheBytes = audioSFXCache.GetTotalBytes();
+
+    report.audioMusicCacheCount = audioMusicCache.GetCount();
+    report.audioMusicCacheBytes = audioMusicCache.GetTotalBytes();
+
+    report.frameArenaBytes = frameArena.GetCapacity();
+
+    for (const auto *object : registeredObjects)
+    {
+        report.AddObject(typeid(*object), object->GetInstanceSize(),
+                         object->GetResourceBytes());
+    }
+
+    report.SortClasses();
+}
+
+inline auto Game::GetMemoryReport() const -> MemoryReport
+{
+    MemoryReport report;
+
+    GetMemoryReport(report);
+
+    return report;
+}
+
+/**
+ * Write a memory report as JSON, to compare scenes against a memory budget.
+ *
+ * @param path File path to write to.
+ */
+inline auto Game::DumpMemoryReport(const std::string &path) const -> bool
+{
+    return GetMemoryReport().Dump(path);
+}
+
+/**
+ * Get the job system used to spread work across threads. The job system is
+ * created on first use and the calling thread, normally the main thread,
+ * becomes one of its workers.
+ */
+inline auto Game::GetJobSystem() -> JobSystem &
+{
+    if (!jobSystem)
+    {
+        jobSystem = std::make_unique<JobSystem>(
+            jobThreadCount > 0 ? jobThreadCount
+                               : JobSystem::GetDefaultThreadCount());
+    }
+
+    return *jobSystem;
+}
+
+/**
+ * Set the number of threads used by the job system, including the main
+ * thread. 0 uses the hardware concurrency. Any existing job system is
+ * finished and recreated on next use.
+ *
+ * @param threadCount Number of threads.
+ */
+inline void Game::SetJobThreadCount(size_t threadCount)
+{
+    jobThreadCount = threadCount;
+
+    jobSystem.reset();
+}
+
+/**
+ * Update top-level children on the job system instead of one after another.
+ * Children marked with RenderObject::SetIsIndependent are split off from
+ * their parent and updated in parallel once their parent has updated.
+ * Changes to shared engine state made during the update, such as adding
+ * children, destroying objects, enabling colliders or pointer events,
+ * changing z, setting text and loading textures or fonts, are deferred until
+ * every object has updated. Buffers passed to the deferred loads must stay
+ * valid until then.
+ *
+ * Update and Start run on job system threads, so any other code in them
+ * must only touch the object's own subtree. Calling SDL renderer or TTF
+ * functions, using the resource caches directly, or reading state that
+ * another subtree changes, such as the bounding box of a shared ancestor, is
+ * not safe. Resource caches assert when used from a job.
+ */
+inline void Game::EnableParallelUpdate() { isParallelUpdateEnabled = true; }
+
+inline void Game::DisableParallelUpdate() { isParallelUpdateEnabled = false; }
+
+inline auto Game::IsParallelUpdateEnabled() const -> bool
+{
+    return isParallelUpdateEnabled;
+}
+
+inline auto Game::IsUpdatingInParallel() const -> bool
+{
+    return isUpdatingInParallel;
+}
+
+/**
+ * Run a command now, or once the parallel update has finished if called
+ * from inside one.
+ *
+ * @param command Command that touches shared engine state.
+ */
+inline void Game::Defer(std::function<void()> command)
+{
+    if (!isUpdatingInParallel)
+    {
+        command();
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(parallelUpdateMutex);
+
+    deferredCommands.emplace_back(std::move(command));
+}
+
+inline void Game::RunDeferredCommands()
+{
+    std::pmr::vector<std::function<void()>> commands(&frameArena);
+
+    commands.reserve(deferredCommands.size());
+
+    std::move(deferredCommands.begin(), deferredCommands.end(),
+              std::back_inserter(commands));
+
+    deferredCommands.clear();
+
+    for (const auto &command : commands)
+    {
+        command();
+    }
+}
+
+inline void Game::AddIndependentObject(RenderObject *object)
+{
+    std::lock_guard<std::mutex> lock(parallelUpdateMutex);
+
+    independentObjects.emplace_back(object);
+}
+
+inline auto Game::GetWindow() -> SDL_Window * { return window; }
+
+inline auto Game::GetRenderer() -> SDL_Renderer * { return renderer; }
+
+inline auto Game::GetViewport() const -> const SDL_FRect & { return viewportf; }
+
+inline void Game::EnableRenderBatching() { isRenderBatchingEnabled = true; }
+
+inline void Game::DisableRenderBatching()
+{
+    FlushRenderBatch();
+
+    isRenderBatchingEnabled = false;
+}
+
+inline auto Game::IsRenderBatchingEnabled() const -> bool
+{
+    return isRenderBatchingEnabled;
+}
+
+inline auto Game::GetRenderBatch() -> RenderBatch & { return renderBatch; }
+
+inline void Game::FlushRenderBatch() { renderBatch.Flush(renderer); }
+
+inline auto Game::SwitchToFullscreen() -> bool
+{
+    auto result = SDL_SetWindowFullscreen(window, SDL_TRUE) == 0;
+
+    if (result)
+    {
+        fullscreen = true;
+    }
+
+    return result;
+}
+
+inline auto Game::SwitchToWindowedMode() -> bool
+{
+    auto result = SDL_SetWindowFullscreen(window, SDL_FALSE) == 0;
+
+    if (result)
+    {
+        SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED,
+                              SDL_WINDOWPOS_CENTERED);
+
+        fullscreen = false;
+    }
+
+    return result;
+}
+
+inline auto Game::IsFullscreen() const -> bool { return fullscreen; }
+
+inline auto Game::IsHeadless() const -> bool { return headless; }
+
+inline auto Game::Setup() -> bool
+{
+    if (headless)
+    {
+        return SetupHeadless();
+    }
+
+    SDL_SetHint(SDL_HINT_WINDOWS_DPI_SCALING, "1");
+
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER) < 0)
+    {
+        return false;
+    }
+
+    if (window != nullptr)
+    {
+        SDL_DestroyWindow(window);
+    }
+
+#ifdef __EMSCRIPTEN__
+    window =
+        SDL_CreateWindow("", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                         width, height, SDL_WINDOW_OPENGL);
+#else
+    window = SDL_CreateWindow("", SDL_WINDOWPOS_CENTERED,
+                              SDL_WINDOWPOS_CENTERED, width, height,
+                              SDL_WINDOW_OPENGL | SDL_WINDOW_ALLOW_HIGHDPI);
+#endif
+
+    SDL_SetWindowResizable(window, SDL_TRUE);
+
+    if (window == nullptr)
+    {
+        SDL_Log("SDL_CreateWindow %s", SDL_GetError());
+
+        return false;
+    }
+
+    if (renderer != nullptr)
+    {
+        SDL_DestroyRenderer(renderer);
+    }
+
+    renderer = SDL_CreateRenderer(
+        window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+
+    if (renderer == nullptr)
+    {
+        SDL_Log("SDL_CreateRenderer %s", SDL_GetError());
+
+        return false;
+    }
+
+    SetScreenSize(width, height);
+
+    return true;
+}
+
+inline auto Game::SetupHeadless() -> bool
+{
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+    if (SDL_Init(SDL_INIT_EVENTS) < 0)
+    {
+        return false;
+    }
+
+    if (renderer != nullptr)
+    {
+        SDL_DestroyRenderer(renderer);
+
+        headlessTarget = nullptr;
+    }
+
+    if (headlessSurface != nullptr)
+    {
+        SDL_FreeSurface(headlessSurface);
+    }
+
+    headlessSurface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+                                                     SDL_PIXELFORMAT_RGBA32);
+
+    if (headlessSurface == nullptr)
+    {
+        SDL_Log("SDL_CreateRGBSurfaceWithFormat %s", SDL_GetError());
+
+        return false;
+    }
+
+    renderer = SDL_CreateSoftwareRenderer(headlessSurface);
+
+    if (renderer == nullptr)
+    {
+        SDL_Log("SDL_CreateSoftwareRenderer %s", SDL_GetError());
+
+        return false;
+    }
+
+    focused = true;
+
+    SetScreenSize(width, height);
+
+    return true;
+}
+
+/**
+ * Render into an offscreen target of the current screen size, or straight
+ * into the headless surface when the sizes match. The software renderer is
+ * bound to its surface, so it is kept and textures created with it stay
+ * valid.
+ */
+inline auto Game::ResizeHeadlessTarget() -> bool
+{
+    SDL_Texture *target = nullptr;
+
+    if (headlessSurface->w != width || headlessSurface->h != height)
+    {
+        target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                   SDL_TEXTUREACCESS_TARGET, width, height);
+
+        if (target == nullptr)
+        {
+            SDL_Log("SDL_CreateTexture %s", SDL_GetError());
+
+            return false;
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, target);
+
+    if (headlessTarget != nullptr)
+    {
+        SDL_DestroyTexture(headlessTarget);
+    }
+
+    headlessTarget = target;
+
+    return true;
+}
+
+inline void Game::SetScreenSize(int _width, int _height)
+{
+    if (headless)
+    {
+        width = _width;
+        height = _height;
+
+        auto targetWidth = headlessSurface->w;
+        auto targetHeight = headlessSurface->h;
+
+        if (headlessTarget != nullptr)
+        {
+            SDL_QueryTexture(headlessTarget, nullptr, nullptr, &targetWidth,
+                             &targetHeight);
+        }
+
+        if ((targetWidth != width || targetHeight != height) &&
+            !ResizeHeadlessTarget())
+        {
+            return;
+        }
+    }
+    else
+    {
+        SDL_SetWindowMinimumSize(window, _width, _height);
+
+        SDL_SetWindowSize(window, _width, _height);
+
+        SDL_GL_GetDrawableSize(window, &width, &height);
+    }
+
+    viewport.w = width;
+    viewport.h = height;
+    viewportf.w = static_cast<float>(viewport.w);
+    viewportf.h = static_cast<float>(viewport.h);
+
+    SDL_RenderSetScale(renderer, 1.0F, 1.0F);
+    SDL_RenderSetLogicalSize(renderer, width, height);
+
+    SDL_RenderSetViewport(renderer, &viewport);
+
+    if (!headless)
+    {
+        SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED,
+                              SDL_WINDOWPOS_CENTERED);
+    }
+}
+
+inline void Game::RecalculateScreenSize()
+{
+    if (headless)
+    {
+        return;
+    }
+
+    SDL_GL_GetDrawableSize(window, &width, &height);
+}
+
+inline void Game::SetTitle(const char *name)
+{
+    SDL_SetWindowTitle(window, name);
+}
+
+inline void Game::SetClearColor(const SDL_Color color)
+{
+    this->clearColor = color;
 }
 
 inline auto Game::GetWidth() const -> int { return viewport.w; }
@@ -561,6 +1476,22 @@ inline void Game::SetFrameRate(double frameRate)
     this->frameRate = frameRate;
 }
 
+inline auto Game::GetFixedDeltaTime() const -> double
+{
+    return fixedDeltaTime;
+}
+
+/**
+ * Use the same delta time every frame instead of measuring it, so runs are
+ * reproducible. Input playback always uses the delta time of the recording.
+ *
+ * @param fixedDeltaTime Delta time in seconds, 0 to measure it.
+ */
+inline void Game::SetFixedDeltaTime(double fixedDeltaTime)
+{
+    this->fixedDeltaTime = fixedDeltaTime;
+}
+
 inline auto Game::GetQuit() const -> bool { return quit; }
 
 inline auto Game::Run() -> int
@@ -579,6 +1510,10 @@ inline auto Game::Run() -> int
 
 inline void Game::Loop()
 {
+    HANDCRANK_PROFILE_ZONE("Loop");
+
+    frameArena.Reset();
+
     framesThisSecond++;
 
     auto frameStart = SDL_GetPerformanceCounter();
@@ -590,18 +1525,78 @@ inline void Game::Loop()
     }
 #endif
 
-    HandleInput();
+    {
+        HANDCRANK_PROFILE_ZONE("UploadDecodedTextures");
+        HANDCRANK_ALLOCATION_PHASE(RENDER);
+
+        UploadDecodedTextures(renderer);
+    }
+
+    {
+        HANDCRANK_PROFILE_ZONE("HandleInput");
+        HANDCRANK_ALLOCATION_PHASE(INPUT);
+
+        HandleInput();
+    }
 
-    PopulateChildrenBuffer();
+    {
+        HANDCRANK_PROFILE_ZONE("PopulateChildrenBuffer");
+        HANDCRANK_ALLOCATION_PHASE(UPDATE);
+
+        PopulateChildrenBuffer();
+    }
+
+    {
+        HANDCRANK_PROFILE_ZONE("DispatchPointerEvents");
+        HANDCRANK_ALLOCATION_PHASE(INPUT);
+
+        DispatchPointerEvents();
+    }
+
+    {
+        HANDCRANK_PROFILE_ZONE("Update");
+        HANDCRANK_ALLOCATION_PHASE(UPDATE);
+
+        Update();
+    }
+
+    if (focused)
+    {
+        HANDCRANK_PROFILE_ZONE("StepAnimations");
+        HANDCRANK_ALLOCATION_PHASE(UPDATE);
+
+        animationScheduler.Step(deltaTime);
+
+        tweens.Step(deltaTime);
+    }
+
+    {
+        HANDCRANK_PROFILE_ZONE("FixedUpdate");
+        HANDCRANK_ALLOCATION_PHASE(FIXED_UPDATE);
+
+        FixedUpdate();
+    }
+
+    {
+        HANDCRANK_PROFILE_ZONE("ResolveCollisions");
+        HANDCRANK_ALLOCATION_PHASE(COLLISIONS);
+
+        ResolveCollisions();
+    }
 
-    Update();
-    FixedUpdate();
+    {
+        HANDCRANK_PROFILE_ZONE("Render");
+        HANDCRANK_ALLOCATION_PHASE(RENDER);
 
-    ResolveCollisions();
+        Render();
+    }
 
-    Render();
+    {
+        HANDCRANK_PROFILE_ZONE("DestroyChildObjects");
+        HANDCRANK_ALLOCATION_PHASE(DESTROY);
 
-    DestroyChildObjects();
+        DestroyChildObjects();
+    }
 
     auto frameEnd = SDL_GetPerformanceCounter();
 
@@ -612,6 +1607,17 @@ inline void Game::Loop()
     deltaTime = std::max(deltaTime, 0.01);
 #endif
 
+    // Recording and playback step with the same delta time so a replayed
+    // session matches the frames it was recorded on.
+    if (IsRecordingInput() || IsPlayingBackInput())
+    {
+        deltaTime = GetInputRecording().GetFixedDeltaTime();
+    }
+    else if (fixedDeltaTime > 0)
+    {
+        deltaTime = fixedDeltaTime;
+    }
+
     float elapsedSeconds = (frameStart - previousFrameStart) /
                            (float)SDL_GetPerformanceFrequency();
 
@@ -622,7 +1628,12 @@ inline void Game::Loop()
         previousFrameStart = frameStart;
     }
 
-    SDL_Delay(1);
+    HANDCRANK_ALLOCATION_END_FRAME();
+
+    if (!headless)
+    {
+        SDL_Delay(1);
+    }
 }
 
 #ifdef __EMSCRIPTEN__
@@ -643,39 +1654,78 @@ inline void Game::HandleInput()
 
     while (SDL_PollEvent(&event) != 0)
     {
-        switch (event.type)
+        if (IsPlayingBackInput() && event.type != SDL_QUIT)
         {
-        case SDL_QUIT:
-            Quit();
-            break;
-
-        case SDL_WINDOWEVENT:
-            if (event.window.event == SDL_WINDOWEVENT_RESIZED ||
-                event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED ||
-                event.window.event == SDL_WINDOWEVENT_DISPLAY_CHANGED)
-            {
-                RecalculateScreenSize();
-            }
-            else if (event.window.event == SDL_WINDOWEVENT_FOCUS_LOST)
-            {
-                focused = false;
-            }
-            else if (event.window.event == SDL_WINDOWEVENT_FOCUS_GAINED)
-            {
-                focused = true;
-            }
-            break;
-        default:
-            break;
+            continue;
         }
 
-        HandleInputPollEvent(event);
+        HandleEvent();
+    }
+
+    while (const auto *playbackEvent = NextPlaybackEvent())
+    {
+        event = *playbackEvent;
+
+        HandleEvent();
+    }
+
+    ResolveActions();
+
+    EndInputFrame();
+}
+
+inline void Game::HandleEvent()
+{
+    switch (event.type)
+    {
+    case SDL_QUIT:
+        Quit();
+        break;
+
+    case SDL_WINDOWEVENT:
+        if (event.window.event == SDL_WINDOWEVENT_RESIZED ||
+            event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED ||
+            event.window.event == SDL_WINDOWEVENT_DISPLAY_CHANGED)
+        {
+            RecalculateScreenSize();
+        }
+        else if (event.window.event == SDL_WINDOWEVENT_FOCUS_LOST)
+        {
+            focused = false;
+        }
+        else if (event.window.event == SDL_WINDOWEVENT_FOCUS_GAINED)
+        {
+            focused = true;
+        }
+        break;
+    default:
+        break;
     }
+
+    HandleInputPollEvent(event);
 }
 
+/**
+ * Snapshot the children of the game and every object whose child list has
+ * changed since the last snapshot. Unchanged subtrees are skipped entirely.
+ */
 inline void Game::PopulateChildrenBuffer()
 {
-    childrenBuffer = children;
+    if (!childrenBufferIsDirty && !descendantChildrenBufferIsDirty)
+    {
+        return;
+    }
+
+    if (childrenBufferIsDirty)
+    {
+        childrenBuffer = children;
+
+        childrenBufferIsDirty = false;
+
+        renderOrderIsDirty = true;
+    }
+
+    descendantChildrenBufferIsDirty = false;
 
     for (const auto &iter : childrenBuffer)
     {
@@ -688,10 +1738,98 @@ inline void Game::PopulateChildrenBuffer()
     }
 }
 
+inline void Game::SetChildrenBufferAsDirty() { childrenBufferIsDirty = true; }
+
+inline void Game::SetRenderOrderAsDirty() { renderOrderIsDirty = true; }
+
+inline auto Game::GetRenderOrderBuffer() -> const std::vector<RenderObject *> &
+{
+    if (renderOrderIsDirty)
+    {
+        PopulateRenderOrderBuffer(childrenBuffer, renderOrderBuffer);
+
+        renderOrderIsDirty = false;
+    }
+
+    return renderOrderBuffer;
+}
+
+/**
+ * Send pointer callbacks to objects that enabled pointer events. Subtrees
+ * without any such object, or whose bounding box doesn't contain the mouse,
+ * are skipped. Callbacks fire top-most object first.
+ */
+inline void Game::DispatchPointerEvents()
+{
+    pointerHits.clear();
+
+    auto mousePosition = GetMousePosition();
+
+    const auto &renderOrder = GetRenderOrderBuffer();
+
+    for (auto it = renderOrder.rbegin(); it != renderOrder.rend(); ++it)
+    {
+        (*it)->CollectPointerHits(mousePosition, pointerHits);
+    }
+
+    for (const auto &weakObject : hoveredObjects)
+    {
+        auto object = weakObject.lock();
+
+        if (object != nullptr &&
+            std::find(pointerHits.begin(), pointerHits.end(), object) ==
+                pointerHits.end())
+        {
+            object->DispatchPointerOut();
+        }
+    }
+
+    hoveredObjects.clear();
+
+    auto isMouseButtonPressed = IsMouseButtonPressed(SDL_BUTTON_LEFT);
+
+    for (const auto &object : pointerHits)
+    {
+        if (object->DispatchPointerOver(isMouseButtonPressed))
+        {
+            activeObjects.emplace_back(object);
+        }
+
+        hoveredObjects.emplace_back(object);
+    }
+
+    if (IsMouseButtonReleased(SDL_BUTTON_LEFT))
+    {
+        for (const auto &weakObject : activeObjects)
+        {
+            if (auto object = weakObject.lock())
+            {
+                object->DispatchPointerUp();
+            }
+        }
+
+        activeObjects.clear();
+    }
+
+    pointerHits.clear();
+}
+
+inline void Game::SetDescendantChildrenBufferAsDirty()
+{
+    descendantChildrenBufferIsDirty = true;
+}
+
 inline void Game::Update()
 {
     elapsedTime += deltaTime;
 
+    if (isParallelUpdateEnabled)
+    {
+        ParallelUpdate(&RenderObject::InternalUpdate, deltaTime);
+
+        return;
+    }
+
     for (const auto &iter : childrenBuffer)
     {
         auto *child = iter.get();
@@ -709,11 +1847,19 @@ inline void Game::FixedUpdate()
 
     if (fixedUpdateDeltaTime > fixedFrameTime)
     {
-        for (const auto &child : childrenBuffer)
+        if (isParallelUpdateEnabled)
+        {
+            ParallelUpdate(&RenderObject::InternalFixedUpdate,
+                           fixedUpdateDeltaTime);
+        }
+        else
         {
-            if (child != nullptr && child->IsEnabled())
+            for (const auto &child : childrenBuffer)
             {
-                child->InternalFixedUpdate(fixedUpdateDeltaTime);
+                if (child != nullptr && child->IsEnabled())
+                {
+                    child->InternalFixedUpdate(fixedUpdateDeltaTime);
+                }
             }
         }
 
@@ -721,70 +1867,183 @@ inline void Game::FixedUpdate()
     }
 }
 
+/**
+ * Update every top-level child on the job system, followed by a wave for
+ * each level of independent subtrees, then run deferred commands.
+ *
+ * @param update Either RenderObject::InternalUpdate or
+ * RenderObject::InternalFixedUpdate.
+ * @param deltaTime Delta time passed to update.
+ */
+inline void Game::ParallelUpdate(void (RenderObject::*update)(double),
+                                 double deltaTime)
+{
+    std::pmr::vector<RenderObject *> wave(&frameArena);
+
+    for (const auto &child : childrenBuffer)
+    {
+        if (child != nullptr && child->IsEnabled())
+        {
+            wave.emplace_back(child.get());
+        }
+    }
+
+    auto &jobSystem = GetJobSystem();
+
+    isUpdatingInParallel = true;
+
+    while (!wave.empty())
+    {
+        jobSystem.ParallelFor(wave.size(), 0,
+                              [&wave, update, deltaTime](size_t start,
+                                                         size_t end)
+                              {
+                                  HANDCRANK_PROFILE_ZONE("ParallelUpdate");
+
+                                  for (auto i = start; i < end; i += 1)
+                                  {
+                                      (wave[i]->*update)(deltaTime);
+                                  }
+                              });
+
+        wave.assign(independentObjects.begin(), independentObjects.end());
+
+        independentObjects.clear();
+    }
+
+    isUpdatingInParallel = false;
+
+    RunDeferredCommands();
+}
+
 inline void Game::Render()
 {
     SDL_SetRenderDrawColor(renderer, clearColor.r, clearColor.g, clearColor.b,
                            clearColor.a);
+    HANDCRANK_RENDER_STATE_CHANGE();
 
     SDL_RenderClear(renderer);
+    HANDCRANK_RENDER_CALL(nullptr);
 
-    sort(childrenBuffer.begin(), childrenBuffer.end(),
-         [](const std::shared_ptr<RenderObject> &a,
-            const std::shared_ptr<RenderObject> &b) { return a->z < b->z; });
-
-    for (const auto &child : childrenBuffer)
+    for (auto *child : GetRenderOrderBuffer())
     {
-        if (child != nullptr && child->IsEnabled())
+        if (child->IsEnabled())
         {
+            HANDCRANK_ALLOCATION_OBJECT(*child);
+            HANDCRANK_RENDER_OBJECT_VISITED();
+
             child->Render(renderer);
         }
     }
 
-    SDL_RenderPresent(renderer);
+    FlushRenderBatch();
+
+    HANDCRANK_RENDER_END_FRAME();
+
+    if (!headless)
+    {
+        HANDCRANK_PROFILE_ZONE("SDL_RenderPresent");
+
+        SDL_RenderPresent(renderer);
+    }
 }
 
 inline void Game::ResolveCollisions()
 {
-    if (colliders.empty())
+    for (const auto &collider : pendingColliders)
     {
-        return;
+        if (!collider->IsCollisionEnabled() ||
+            collider->HasBeenMarkedForDestroy())
+        {
+            continue;
+        }
+
+        // Re-enabled before its proxy was removed. Moves made while it was
+        // disabled weren't tracked, so refresh the proxy.
+        if (colliderProxies.find(collider.get()) != colliderProxies.end())
+        {
+            dirtyColliders.emplace_back(collider.get());
+
+            continue;
+        }
+
+        auto id = colliderSpatialHash.Insert(collider->GetTransformedRect());
+
+        if (id >= colliders.size())
+        {
+            colliders.resize(id + 1);
+        }
+
+        colliders[id] = collider;
+
+        colliderProxies.emplace(collider.get(), id);
     }
 
-    colliders.erase(
-        std::remove_if(colliders.begin(), colliders.end(),
-                       [](const std::shared_ptr<RenderObject> &collider)
-                       {
-                           return !collider->IsCollisionEnabled() ||
-                                  collider->HasBeenMarkedForDestroy();
-                       }),
-        colliders.end());
+    pendingColliders.clear();
+
+    for (auto *collider : dirtyColliders)
+    {
+        auto match = colliderProxies.find(collider);
+
+        if (match != colliderProxies.end())
+        {
+            colliderSpatialHash.Update(match->second,
+                                       collider->GetTransformedRect());
+        }
+    }
 
-    const auto count = colliders.size();
+    dirtyColliders.clear();
 
-    if (count <= 1)
+    for (size_t id = 0; id < colliders.size(); id += 1)
     {
-        return;
+        const auto &collider = colliders[id];
+
+        if (collider != nullptr && (!collider->IsCollisionEnabled() ||
+                                    collider->HasBeenMarkedForDestroy()))
+        {
+            colliderProxies.erase(collider.get());
+
+            colliderSpatialHash.Remove(id);
+
+            colliders[id] = nullptr;
+        }
     }
 
-    for (auto i = 0; i < count - 1; i += 1)
+    if (colliderProxies.size() <= 1)
     {
-        const auto &rectA = colliders[i]->GetTransformedRect();
+        return;
+    }
 
-        for (auto j = i + 1; j < count; j += 1)
+    colliderSpatialHash.ForEachCandidatePair(
+        [this](size_t idA, size_t idB)
         {
-            const auto &rectB = colliders[j]->GetTransformedRect();
+            const auto &colliderA = colliders[idA];
+            const auto &colliderB = colliders[idB];
+
+            const auto &rectA = colliderA->GetTransformedRect();
+            const auto &rectB = colliderB->GetTransformedRect();
 
             if (SDL_HasIntersectionF(&rectA, &rectB) == SDL_TRUE)
             {
-                colliders[i]->OnCollision(colliders[j]);
-                colliders[j]->OnCollision(colliders[i]);
+                colliderA->OnCollision(colliderB);
+                colliderB->OnCollision(colliderA);
             }
-        }
-    }
+        });
 }
 
 inline void Game::DestroyChildObjects()
 {
+    if (!descendantIsMarkedForDestroy)
+    {
+        return;
+    }
+
+    descendantIsMarkedForDestroy = false;
+
+    UnregisterDestroyedObjects();
+
+    tweens.KillDestroyed();
+
     for (const auto &child : children)
     {
         if (child != nullptr)
@@ -793,6 +2052,8 @@ inline void Game::DestroyChildObjects()
         }
     }
 
+    auto previousCount = children.size();
+
     children.erase(std::remove_if(children.begin(), children.end(),
                                   [](const auto &child)
                                   {
@@ -801,11 +2062,23 @@ inline void Game::DestroyChildObjects()
                                       {
                                           child->OnDestroy();
 
+                                          child->ReturnToPool();
+
                                           return true;
                                       }
                                       return false;
                                   }),
                    children.end());
+
+    if (children.size() != previousCount)
+    {
+        SetChildrenBufferAsDirty();
+    }
+}
+
+inline void Game::SetDescendantAsMarkedForDestroy()
+{
+    descendantIsMarkedForDestroy = true;
 }
 
 inline void Game::Quit() { quit = true; }
@@ -814,6 +2087,15 @@ inline void Game::Quit() { quit = true; }
 inline void Game::ToggleDebug(bool state) { debug = state; }
 inline void Game::ToggleDebug() { debug = !debug; }
 inline auto Game::IsDebug() const -> bool { return debug; }
+
+/**
+ * Get the number of render calls, texture binds, state changes and visited
+ * and culled objects in the last rendered frame.
+ */
+inline auto Game::GetRenderStats() const -> const RenderStats &
+{
+    return previousRenderStats;
+}
 #endif
 
 inline RenderObject::RenderObject()
@@ -859,11 +2141,117 @@ inline void RenderObject::Disable()
 
 inline auto RenderObject::IsEnabled() const -> bool { return isEnabled; }
 
+/**
+ * Check if this object and every one of its ancestors are enabled, which is
+ * when the render tree would update it.
+ */
+inline auto RenderObject::IsEnabledInHierarchy() const -> bool
+{
+    for (const auto *object = this; object != nullptr; object = object->parent)
+    {
+        if (!object->IsEnabled())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 inline auto RenderObject::IsCollisionEnabled() const -> bool
 {
     return isCollisionEnabled;
 }
 
+inline auto RenderObject::IsIndependent() const -> bool
+{
+    return isIndependent;
+}
+
+/**
+ * Mark this object as independent of its siblings. During a parallel update
+ * independent objects and their children are updated on their own job after
+ * their parent has updated.
+ *
+ * @param isIndependent Independent state.
+ */
+inline void RenderObject::SetIsIndependent(bool isIndependent)
+{
+    this->isIndependent = isIndependent;
+}
+
+inline auto RenderObject::IsRegistered() const -> bool { return isRegistered; }
+
+inline void RenderObject::SetIsRegistered(bool isRegistered)
+{
+    this->isRegistered = isRegistered;
+}
+
+inline auto RenderObject::GetPool() const -> RenderObjectPoolBase *
+{
+    return pool;
+}
+
+inline void RenderObject::SetPool(RenderObjectPoolBase *pool)
+{
+    this->pool = pool;
+}
+
+/**
+ * Reset engine state so a pooled object can be added to the game again, then
+ * call OnReuse. Children, the parent and the game are detached, Start runs
+ * again on the next update and colliders and pointer events are disabled.
+ * Position, size, name, tag and z are left for OnReuse to reset.
+ */
+inline void RenderObject::ResetForReuse()
+{
+    children.clear();
+    childrenBuffer.clear();
+    renderOrderBuffer.clear();
+
+    childrenBufferIsDirty = true;
+    descendantChildrenBufferIsDirty = false;
+    renderOrderIsDirty = true;
+    descendantIsMarkedForDestroy = false;
+
+    hasStarted = false;
+    isEnabled = true;
+    isCollisionEnabled = false;
+    isMarkedForDestroy = false;
+    isPointerEventsEnabled = false;
+    isInputHovered = false;
+    isInputActive = false;
+
+    pointerEventsInSubtreeIsDirty = true;
+
+    transformedRectIsDirty = true;
+    boundingBoxIsDirty = true;
+
+    // Otherwise the stale proxy is still there if this object is reacquired
+    // and its collider enabled before the next ResolveCollisions, which
+    // would then skip it and keep its old rect.
+    if (game != nullptr)
+    {
+        game->RemoveCollider(this);
+    }
+
+    parent = nullptr;
+    game = nullptr;
+
+    OnReuse();
+}
+
+/**
+ * Hand this object back to the pool it was acquired from, if any.
+ */
+inline void RenderObject::ReturnToPool()
+{
+    if (pool != nullptr)
+    {
+        pool->Release(this);
+    }
+}
+
 inline auto RenderObject::GetIndex() const -> int { return index; }
 
 inline auto RenderObject::GetName() const -> std::string
@@ -879,13 +2267,52 @@ inline auto RenderObject::GetTag() const -> std::string
 {
     return tag.empty() ? "untagged" : tag;
 }
-inline void RenderObject::SetTag(const std::string &tag) { this->tag = tag; }
+inline void RenderObject::SetTag(const std::string &tag)
+{
+    if (game != nullptr && game->IsUpdatingInParallel())
+    {
+        game->Defer([self = shared_from_this(), tag] { self->SetTag(tag); });
+
+        return;
+    }
+
+    auto previousTag = GetTag();
+
+    this->tag = tag;
+
+    if (game != nullptr)
+    {
+        game->UpdateObjectTag(this, previousTag);
+    }
+}
 
 inline auto RenderObject::GetClassName() const -> std::string
 {
     return GetClassNameSimple(*this);
 }
 
+/**
+ * Size of the object for memory reports. Classes that add members override
+ * this to return sizeof their own type, objects of classes that don't are
+ * counted at the size of the closest engine class.
+ */
+inline auto RenderObject::GetInstanceSize() const -> size_t
+{
+    return sizeof(RenderObject);
+}
+
+/**
+ * Memory the object owns outside of itself for memory reports, such as the
+ * storage of its children lists. Shared resources held by a cache are counted
+ * by the cache instead.
+ */
+inline auto RenderObject::GetResourceBytes() const -> size_t
+{
+    return (children.capacity() + childrenBuffer.capacity()) *
+               sizeof(std::shared_ptr<RenderObject>) +
+           renderOrderBuffer.capacity() * sizeof(RenderObject *);
+}
+
 inline auto RenderObject::ShowInHierarchy() const -> std::string
 {
     if (parent != nullptr)
@@ -909,7 +2336,24 @@ RenderObject::AddChildObject(const std::shared_ptr<RenderObject> &child)
 
     child->game = game;
 
+    if (game->IsUpdatingInParallel())
+    {
+        game->Defer([self = shared_from_this(), child]
+                    { self->AddChildObject(child); });
+
+        return;
+    }
+
     children.emplace_back(child);
+
+    game->RegisterObject(child.get());
+
+    SetChildrenBufferAsDirty();
+
+    if (child->HasBeenMarkedForDestroy())
+    {
+        SetDescendantAsMarkedForDestroy();
+    }
 }
 
 template <typename T>
@@ -921,6 +2365,23 @@ inline auto RenderObject::GetChildrenByType(bool nested)
 
     std::vector<std::shared_ptr<T>> results;
 
+    CollectChildrenByType(results, nested);
+
+    return results;
+}
+
+/**
+ * Append children of type T, or derived from it, to a vector. Pass a
+ * std::pmr::vector using Game::GetFrameMemoryResource to collect into frame
+ * memory instead of the heap.
+ *
+ * @param results Vector to append to.
+ * @param nested Include descendants of children.
+ */
+template <typename T, typename Allocator>
+inline void RenderObject::CollectChildrenByType(
+    std::vector<std::shared_ptr<T>, Allocator> &results, bool nested)
+{
     for (const auto &child : childrenBuffer)
     {
         if (child == nullptr)
@@ -935,14 +2396,9 @@ inline auto RenderObject::GetChildrenByType(bool nested)
 
         if (nested)
         {
-            auto childResults = child->GetChildrenByType<T>(nested);
-
-            results.insert(results.end(), childResults.begin(),
-                           childResults.end());
+            child->CollectChildrenByType(results, nested);
         }
     }
-
-    return results;
 }
 
 template <typename T>
@@ -981,7 +2437,23 @@ inline auto RenderObject::GetChildCount() -> int { return children.size(); }
 
 inline void RenderObject::PopulateChildrenBuffer()
 {
-    childrenBuffer = children;
+    if (!childrenBufferIsDirty && !descendantChildrenBufferIsDirty)
+    {
+        return;
+    }
+
+    if (childrenBufferIsDirty)
+    {
+        childrenBuffer = children;
+
+        childrenBufferIsDirty = false;
+
+        renderOrderIsDirty = true;
+
+        SetPointerEventsInSubtreeAsDirty();
+    }
+
+    descendantChildrenBufferIsDirty = false;
 
     for (const auto &iter : childrenBuffer)
     {
@@ -994,74 +2466,324 @@ inline void RenderObject::PopulateChildrenBuffer()
     }
 }
 
-inline void RenderObject::Start() {}
+inline void RenderObject::SetChildrenBufferAsDirty()
+{
+    childrenBufferIsDirty = true;
 
-inline void RenderObject::Update(double deltaTime) {}
+    if (parent != nullptr)
+    {
+        parent->SetDescendantChildrenBufferAsDirty();
+    }
+    else if (game != nullptr)
+    {
+        game->SetDescendantChildrenBufferAsDirty();
+    }
+}
 
-inline void RenderObject::FixedUpdate(double deltaTime) {}
+inline void RenderObject::SetDescendantChildrenBufferAsDirty()
+{
+    if (descendantChildrenBufferIsDirty)
+    {
+        return;
+    }
 
-inline void RenderObject::OnMouseOver() {}
+    descendantChildrenBufferIsDirty = true;
 
-inline void RenderObject::OnMouseOut() {}
+    if (parent != nullptr)
+    {
+        parent->SetDescendantChildrenBufferAsDirty();
+    }
+    else if (game != nullptr)
+    {
+        game->SetDescendantChildrenBufferAsDirty();
+    }
+}
 
-inline void RenderObject::OnMouseDown() {}
+inline auto RenderObject::GetRenderOrderBuffer()
+    -> const std::vector<RenderObject *> &
+{
+    if (renderOrderIsDirty)
+    {
+        PopulateRenderOrderBuffer(childrenBuffer, renderOrderBuffer);
 
-inline void RenderObject::OnMouseUp() {}
+        renderOrderIsDirty = false;
+    }
 
-inline void
-RenderObject::OnCollision(const std::shared_ptr<RenderObject> &other)
+    return renderOrderBuffer;
+}
+
+/**
+ * Receive OnMouseOver, OnMouseOut, OnMouseDown and OnMouseUp callbacks.
+ * Objects without pointer events enabled are never hit tested, so overriding
+ * the callbacks alone no longer receives them.
+ */
+inline void RenderObject::EnablePointerEvents()
 {
+    // Marking the subtree dirty walks and writes every ancestor.
+    if (game != nullptr && game->IsUpdatingInParallel())
+    {
+        game->Defer([self = shared_from_this()]
+                    { self->EnablePointerEvents(); });
+
+        return;
+    }
+
+    isPointerEventsEnabled = true;
+
+    SetPointerEventsInSubtreeAsDirty();
 }
 
-inline void RenderObject::InternalUpdate(double deltaTime)
+inline void RenderObject::DisablePointerEvents()
 {
-    if (!hasStarted)
+    if (game != nullptr && game->IsUpdatingInParallel())
     {
-        Start();
+        game->Defer([self = shared_from_this()]
+                    { self->DisablePointerEvents(); });
 
-        hasStarted = true;
+        return;
     }
 
-    auto transformedRect = GetTransformedRect();
+    isPointerEventsEnabled = false;
 
-    auto mousePosition = game->GetMousePosition();
+    SetPointerEventsInSubtreeAsDirty();
+}
+
+inline auto RenderObject::IsPointerEventsEnabled() const -> bool
+{
+    return isPointerEventsEnabled;
+}
 
-    if (SDL_PointInFRect(&mousePosition, &transformedRect) == SDL_TRUE)
+/**
+ * Check if this object or any of its descendants has pointer events enabled.
+ */
+inline auto RenderObject::HasPointerEventsInSubtree() const -> bool
+{
+    if (pointerEventsInSubtreeIsDirty)
     {
-        if (game->IsMouseButtonPressed(SDL_BUTTON_LEFT))
-        {
-            OnMouseDown();
+        hasPointerEventsInSubtree = isPointerEventsEnabled;
 
-            isInputActive = true;
+        // Visit every child so none are left dirty under a clean parent.
+        for (const auto &child : childrenBuffer)
+        {
+            if (child != nullptr && child->HasPointerEventsInSubtree())
+            {
+                hasPointerEventsInSubtree = true;
+            }
         }
 
-        if (!isInputHovered)
-        {
-            OnMouseOver();
+        pointerEventsInSubtreeIsDirty = false;
+    }
 
-            isInputHovered = true;
+    return hasPointerEventsInSubtree;
+}
+
+inline void RenderObject::SetPointerEventsInSubtreeAsDirty()
+{
+    if (pointerEventsInSubtreeIsDirty)
+    {
+        return;
+    }
+
+    pointerEventsInSubtreeIsDirty = true;
+
+    if (parent != nullptr)
+    {
+        parent->SetPointerEventsInSubtreeAsDirty();
+    }
+}
+
+/**
+ * Collect this object and its descendants under a point, top-most first.
+ *
+ * @param point Point in screen space.
+ * @param hits Objects with pointer events enabled that contain the point.
+ */
+inline void RenderObject::CollectPointerHits(
+    const SDL_FPoint &point, std::vector<std::shared_ptr<RenderObject>> &hits)
+{
+    if (!IsEnabled() || !HasPointerEventsInSubtree())
+    {
+        return;
+    }
+
+    const auto &boundingBox = GetBoundingBox();
+
+    if (SDL_PointInFRect(&point, &boundingBox) != SDL_TRUE)
+    {
+        return;
+    }
+
+    const auto &renderOrder = GetRenderOrderBuffer();
+
+    for (auto it = renderOrder.rbegin(); it != renderOrder.rend(); ++it)
+    {
+        (*it)->CollectPointerHits(point, hits);
+    }
+
+    if (isPointerEventsEnabled)
+    {
+        const auto &transformedRect = GetTransformedRect();
+
+        if (SDL_PointInFRect(&point, &transformedRect) == SDL_TRUE)
+        {
+            hits.emplace_back(shared_from_this());
         }
     }
-    else if (isInputHovered)
+}
+
+inline auto RenderObject::IsInputHovered() const -> bool
+{
+    return isInputHovered;
+}
+
+inline auto RenderObject::IsInputActive() const -> bool
+{
+    return isInputActive;
+}
+
+/**
+ * Handle the pointer being over this object.
+ *
+ * @param isPressed If the left mouse button was pressed this frame.
+ *
+ * @return If this object just became active.
+ */
+inline auto RenderObject::DispatchPointerOver(bool isPressed) -> bool
+{
+    auto becameActive = false;
+
+    if (isPressed)
+    {
+        OnMouseDown();
+
+        becameActive = !isInputActive;
+
+        isInputActive = true;
+    }
+
+    if (!isInputHovered)
+    {
+        OnMouseOver();
+
+        isInputHovered = true;
+    }
+
+    return becameActive;
+}
+
+inline void RenderObject::DispatchPointerOut()
+{
+    if (isInputHovered)
     {
         OnMouseOut();
 
         isInputHovered = false;
     }
+}
 
-    if (isInputActive && game->IsMouseButtonReleased(SDL_BUTTON_LEFT))
+inline void RenderObject::DispatchPointerUp()
+{
+    if (isInputActive)
     {
         OnMouseUp();
 
         isInputActive = false;
     }
+}
+
+inline auto RenderObject::GetZ() const -> int { return z; }
+
+inline void RenderObject::SetZ(int z)
+{
+    if (this->z == z)
+    {
+        return;
+    }
+
+    this->z = z;
+
+    if (game != nullptr && game->IsUpdatingInParallel())
+    {
+        game->Defer(
+            [self = shared_from_this()]
+            {
+                if (self->parent != nullptr)
+                {
+                    self->parent->SetRenderOrderAsDirty();
+                }
+                else
+                {
+                    self->game->SetRenderOrderAsDirty();
+                }
+            });
+
+        return;
+    }
+
+    if (parent != nullptr)
+    {
+        parent->SetRenderOrderAsDirty();
+    }
+    else if (game != nullptr)
+    {
+        game->SetRenderOrderAsDirty();
+    }
+}
+
+inline void RenderObject::SetRenderOrderAsDirty() { renderOrderIsDirty = true; }
+
+inline void RenderObject::Start() {}
+
+inline void RenderObject::Update(double deltaTime) {}
+
+inline void RenderObject::FixedUpdate(double deltaTime) {}
+
+inline void RenderObject::OnMouseOver() {}
+
+inline void RenderObject::OnMouseOut() {}
+
+inline void RenderObject::OnMouseDown() {}
+
+inline void RenderObject::OnMouseUp() {}
+
+inline void
+RenderObject::OnCollision(const std::shared_ptr<RenderObject> &other)
+{
+}
+
+inline void RenderObject::InternalUpdate(double deltaTime)
+{
+    {
+        HANDCRANK_ALLOCATION_OBJECT(*this);
+
+        if (!hasStarted)
+        {
+            Start();
+
+            hasStarted = true;
+        }
 
-    Update(deltaTime);
+        Update(deltaTime);
+    }
 
     for (const auto &child : childrenBuffer)
     {
         if (child != nullptr && child->IsEnabled())
         {
+            if (child->IsIndependent() && game->IsUpdatingInParallel())
+            {
+                // Resolve this transform before the child reads it from
+                // another thread.
+                if (transformedRectIsDirty)
+                {
+                    SetTransformedRect();
+                }
+
+                game->AddIndependentObject(child.get());
+
+                continue;
+            }
+
             child->InternalUpdate(deltaTime);
         }
     }
@@ -1069,12 +2791,30 @@ inline void RenderObject::InternalUpdate(double deltaTime)
 
 inline void RenderObject::InternalFixedUpdate(double fixedDeltaTime)
 {
-    FixedUpdate(fixedDeltaTime);
+    {
+        HANDCRANK_ALLOCATION_OBJECT(*this);
+
+        FixedUpdate(fixedDeltaTime);
+    }
 
     for (const auto &child : childrenBuffer)
     {
         if (child != nullptr && child->IsEnabled())
         {
+            if (child->IsIndependent() && game->IsUpdatingInParallel())
+            {
+                // Resolve this transform before the child reads it from
+                // another thread.
+                if (transformedRectIsDirty)
+                {
+                    SetTransformedRect();
+                }
+
+                game->AddIndependentObject(child.get());
+
+                continue;
+            }
+
             child->InternalFixedUpdate(fixedDeltaTime);
         }
     }
@@ -1082,6 +2822,12 @@ inline void RenderObject::InternalFixedUpdate(double fixedDeltaTime)
 
 inline void RenderObject::OnDestroy() {}
 
+/**
+ * Called when a pooled object is returned to its pool after being destroyed.
+ * Override to reset any state the next user of the object shouldn't see.
+ */
+inline void RenderObject::OnReuse() {}
+
 inline auto RenderObject::GetRect() const -> const SDL_FRect & { return rect; }
 
 inline void RenderObject::SetRect(const SDL_FRect &rect)
@@ -1208,6 +2954,11 @@ inline void RenderObject::SetTransformedRectAsDirty()
 
     transformedRectIsDirty = true;
 
+    if (isCollisionEnabled && game != nullptr)
+    {
+        game->SetColliderAsDirty(this);
+    }
+
     for (const auto &child : children)
     {
         child->SetTransformedRectAsDirty();
@@ -1252,13 +3003,11 @@ inline void RenderObject::SetBoundingBox() const
 
 inline void RenderObject::SetBoundingBoxAsDirty()
 {
-    if (boundingBoxIsDirty)
+    if (boundingBoxIsDirty.exchange(true))
     {
         return;
     }
 
-    boundingBoxIsDirty = true;
-
     if (parent != nullptr)
     {
         parent->SetBoundingBoxAsDirty();
@@ -1279,7 +3028,14 @@ inline auto RenderObject::CanRender() const -> bool
 
     auto viewport = game->GetViewport();
 
-    return SDL_HasIntersectionF(&boundingBox, &viewport) == SDL_TRUE;
+    if (SDL_HasIntersectionF(&boundingBox, &viewport) != SDL_TRUE)
+    {
+        HANDCRANK_RENDER_OBJECT_CULLED();
+
+        return false;
+    }
+
+    return true;
 }
 
 inline void RenderObject::Render(SDL_Renderer *renderer)
@@ -1289,14 +3045,13 @@ inline void RenderObject::Render(SDL_Renderer *renderer)
         return;
     }
 
-    sort(childrenBuffer.begin(), childrenBuffer.end(),
-         [](const std::shared_ptr<RenderObject> &a,
-            const std::shared_ptr<RenderObject> &b) { return a->z < b->z; });
-
-    for (const auto &child : childrenBuffer)
+    for (auto *child : GetRenderOrderBuffer())
     {
-        if (child != nullptr && child->IsEnabled())
+        if (child->IsEnabled())
         {
+            HANDCRANK_ALLOCATION_OBJECT(*child);
+            HANDCRANK_RENDER_OBJECT_VISITED();
+
             child->Render(renderer);
         }
     }
@@ -1324,8 +3079,11 @@ inline void RenderObject::Render(SDL_Renderer *renderer)
             }
         }
 
+        game->FlushRenderBatch();
+
         SDL_RenderCopyF(renderer, debugRectTexture.get(), nullptr,
                         &transformedRect);
+        HANDCRANK_RENDER_CALL(debugRectTexture.get());
     }
 #endif
 }
@@ -1340,6 +3098,13 @@ inline auto RenderObject::CheckCollisionAABB(
 
 inline void RenderObject::DestroyChildObjects()
 {
+    if (!descendantIsMarkedForDestroy)
+    {
+        return;
+    }
+
+    descendantIsMarkedForDestroy = false;
+
     for (const auto &child : children)
     {
         if (child != nullptr)
@@ -1348,6 +3113,8 @@ inline void RenderObject::DestroyChildObjects()
         }
     }
 
+    auto previousCount = children.size();
+
     children.erase(std::remove_if(children.begin(), children.end(),
                                   [](const auto &child)
                                   {
@@ -1356,11 +3123,18 @@ inline void RenderObject::DestroyChildObjects()
                                       {
                                           child->OnDestroy();
 
+                                          child->ReturnToPool();
+
                                           return true;
                                       }
                                       return false;
                                   }),
                    children.end());
+
+    if (children.size() != previousCount)
+    {
+        SetChildrenBufferAsDirty();
+    }
 }
 
 inline auto RenderObject::HasBeenMarkedForDestroy() const -> bool
@@ -1368,12 +3142,47 @@ inline auto RenderObject::HasBeenMarkedForDestroy() const -> bool
     return isMarkedForDestroy;
 }
 
+inline void RenderObject::SetDescendantAsMarkedForDestroy()
+{
+    if (descendantIsMarkedForDestroy)
+    {
+        return;
+    }
+
+    descendantIsMarkedForDestroy = true;
+
+    if (parent != nullptr)
+    {
+        parent->SetDescendantAsMarkedForDestroy();
+    }
+    else if (game != nullptr)
+    {
+        game->SetDescendantAsMarkedForDestroy();
+    }
+}
+
 inline void RenderObject::Destroy()
 {
+    if (game != nullptr && game->IsUpdatingInParallel())
+    {
+        game->Defer([self = shared_from_this()] { self->Destroy(); });
+
+        return;
+    }
+
     isMarkedForDestroy = true;
 
     DisableCollider();
 
+    if (parent != nullptr)
+    {
+        parent->SetDescendantAsMarkedForDestroy();
+    }
+    else if (game != nullptr)
+    {
+        game->SetDescendantAsMarkedForDestroy();
+    }
+
     for (const auto &child : children)
     {
         if (child != nullptr)
@@ -1381,6 +3190,65 @@ inline void RenderObject::Destroy()
             child->Destroy();
         }
     }
+
+    // Objects that were never added to the game have no parent to remove
+    // them, so go straight back to the pool.
+    if (pool != nullptr && parent == nullptr && game == nullptr)
+    {
+        OnDestroy();
+
+        ReturnToPool();
+    }
+}
+
+inline auto GetTweenProperty(const RenderObject *object,
+                             TweenProperty property) -> float
+{
+    switch (property)
+    {
+    case TweenProperty::X:
+        return object->GetRect().x;
+    case TweenProperty::Y:
+        return object->GetRect().y;
+    case TweenProperty::SCALE:
+        return object->GetScale();
+    default:
+        return 0;
+    }
+}
+
+inline void SetTweenProperty(RenderObject *object, TweenProperty property,
+                             float value)
+{
+    switch (property)
+    {
+    case TweenProperty::X:
+        object->SetPosition(value, object->GetRect().y);
+        break;
+    case TweenProperty::Y:
+        object->SetPosition(object->GetRect().x, value);
+        break;
+    case TweenProperty::SCALE:
+        object->SetScale(value);
+        break;
+    default:
+        break;
+    }
+}
+
+inline auto IsTweenObjectDestroyed(const RenderObject *object) -> bool
+{
+    return object->HasBeenMarkedForDestroy();
+}
+
+inline auto IsTweenGameUpdatingInParallel(const Game *game) -> bool
+{
+    return game->IsUpdatingInParallel();
+}
+
+inline void DeferTweenCommand(Game *game, std::function<void()> command)
+{
+    game->Defer(std::move(command));
 }
 
 } // namespace HandcrankEngine
@@ -36,6 +36,11 @@ class ImageRenderObject : public TextureRenderObject
   public:
     using TextureRenderObject::TextureRenderObject;
 
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(ImageRenderObject);
+    }
+
     void SetSrcRect(const SDL_Rect &srcRect)
     {
         this->srcRect.x = srcRect.x;
@@ -86,19 +91,66 @@ class ImageRenderObject : public TextureRenderObject
      */
     void Render(SDL_Renderer *renderer) override
     {
-        if (!CanRender() || texture == nullptr)
+        UpdateTextureFromLoadHandle();
+
+        auto *renderTexture = GetRenderTexture();
+
+        if (!CanRender() || renderTexture == nullptr)
         {
             return;
         }
 
         auto transformedRect = GetTransformedRect();
 
-        SDL_SetTextureColorMod(texture, tintColor.r, tintColor.g, tintColor.b);
+        auto useSrcRect = srcRectSet && !IsTextureLoading();
 
-        SDL_SetTextureAlphaMod(texture, alpha);
+        auto renderSrcRect =
+            useSrcRect ? srcRect : SDL_Rect{0, 0, textureWidth, textureHeight};
 
-        SDL_RenderCopyExF(renderer, texture, srcRectSet ? &srcRect : nullptr,
-                          &transformedRect, 0, &centerPoint, flip);
+        auto renderTextureWidth = textureWidth;
+        auto renderTextureHeight = textureHeight;
+
+        if (textureRegion != nullptr)
+        {
+            renderSrcRect.x += textureRegion->rect.x;
+            renderSrcRect.y += textureRegion->rect.y;
+
+            renderTextureWidth = textureRegion->textureWidth;
+            renderTextureHeight = textureRegion->textureHeight;
+        }
+
+        if (game->IsRenderBatchingEnabled() && renderTextureWidth > 0 &&
+            renderTextureHeight > 0)
+        {
+            game->GetRenderBatch().AddQuad(
+                renderer, renderTexture, transformedRect,
+                {static_cast<float>(renderSrcRect.x),
+                 static_cast<float>(renderSrcRect.y),
+                 static_cast<float>(renderSrcRect.w),
+                 static_cast<float>(renderSrcRect.h)},
+                {tintColor.r, tintColor.g, tintColor.b,
+                 static_cast<Uint8>(std::clamp(alpha, 0, MAX_ALPHA))},
+                static_cast<float>(renderTextureWidth),
+                static_cast<float>(renderTextureHeight), flip);
+        }
+        else
+        {
+            game->FlushRenderBatch();
+
+            SDL_SetTextureColorMod(renderTexture, tintColor.r, tintColor.g,
+                                   tintColor.b);
+            HANDCRANK_RENDER_STATE_CHANGE();
+
+            SDL_SetTextureAlphaMod(renderTexture, alpha);
+            HANDCRANK_RENDER_STATE_CHANGE();
+
+            SDL_RenderCopyExF(renderer, renderTexture,
+                              useSrcRect || textureRegion != nullptr
+                                  ? &renderSrcRect
+                                  : nullptr,
+                              &transformedRect, 0, &centerPoint, flip);
+            HANDCRANK_RENDER_CALL(renderTexture);
+        }
 
         RenderObject::Render(renderer);
     }
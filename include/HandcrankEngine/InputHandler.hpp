@@ -9,41 +9,117 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <string>
 #include <vector>
 
 #include <SDL.h>
 
+#include "InputRecording.hpp"
+
 namespace HandcrankEngine
 {
 
-inline const int DEFAULT_KEY_MAP_SIZE = 250;
-inline const int DEFAULT_MOUSE_BUTTON_MAP_SIZE = 48;
+inline const int KEY_CODE_LOOKUP_SIZE = 128;
+inline const int MOUSE_BUTTON_COUNT = 256;
 inline const int DEFAULT_CONNECTED_GAME_CONTROLLER_MAP_SIZE = 12;
-inline const int DEFAULT_GAME_CONTROLLER_BUTTON_MAP_SIZE = 25;
+inline const int MAX_INPUT_ACTIONS = 64;
+
+using KeyState = std::bitset<SDL_NUM_SCANCODES>;
+using MouseButtonState = std::bitset<MOUSE_BUTTON_COUNT>;
+using ControllerButtonState = std::bitset<SDL_CONTROLLER_BUTTON_MAX>;
+using InputActionState = std::bitset<MAX_INPUT_ACTIONS>;
+
+enum class InputBindingType : Uint8
+{
+    KEY,
+    MOUSE_BUTTON,
+    CONTROLLER_BUTTON
+};
+
+/**
+ * Binds a key, mouse button or controller button to an action.
+ */
+struct InputBinding
+{
+    size_t action;
+
+    InputBindingType type;
+
+    int code;
+};
+
+/**
+ * Button state of a single connected controller.
+ */
+struct ControllerState
+{
+    SDL_JoystickID id;
+
+    SDL_GameController *controller;
+
+    ControllerButtonState buttonState;
+    ControllerButtonState buttonPressedState;
+    ControllerButtonState buttonReleasedState;
+};
 
 class InputHandler
 {
   protected:
     SDL_Event event;
 
-    std::unordered_map<SDL_Keycode, bool> keyState;
-    std::unordered_map<SDL_Keycode, bool> keyPressedState;
-    std::unordered_map<SDL_Keycode, bool> keyReleasedState;
+    KeyState keyState;
+    KeyState keyPressedState;
+    KeyState keyReleasedState;
+
+    std::array<SDL_Scancode, KEY_CODE_LOOKUP_SIZE> keyCodeScancodes{};
 
     SDL_FPoint mousePosition{};
 
-    std::unordered_map<Uint8, bool> mouseState;
-    std::unordered_map<Uint8, bool> mousePressedState;
-    std::unordered_map<Uint8, bool> mouseReleasedState;
+    MouseButtonState mouseState;
+    MouseButtonState mousePressedState;
+    MouseButtonState mouseReleasedState;
+
+    std::vector<ControllerState> connectedControllers;
 
-    std::unordered_map<Uint8, SDL_GameController *> connectedControllers;
+    ControllerButtonState controllerButtonState;
+    ControllerButtonState controllerButtonPressedState;
+    ControllerButtonState controllerButtonReleasedState;
 
-    std::unordered_map<SDL_GameControllerButton, bool> controllerButtonState;
-    std::unordered_map<SDL_GameControllerButton, bool>
-        controllerButtonPressedState;
-    std::unordered_map<SDL_GameControllerButton, bool>
-        controllerButtonReleasedState;
+    std::vector<InputBinding> actionBindings;
+
+    InputActionState actionState;
+    InputActionState actionPressedState;
+    InputActionState actionReleasedState;
+
+    InputRecording inputRecording;
+
+    bool isRecordingInput = false;
+    bool isPlayingBackInput = false;
+
+    Uint32 inputFrame = 0;
+
+    Uint32 inputRecordingStartTicks = 0;
+
+    size_t playbackEventIndex = 0;
+
+    [[nodiscard]] inline auto GetScancode(SDL_Keycode keyCode) const
+        -> SDL_Scancode;
+
+    [[nodiscard]] inline auto FindController(SDL_JoystickID id)
+        -> ControllerState *;
+    [[nodiscard]] inline auto FindController(SDL_JoystickID id) const
+        -> const ControllerState *;
+
+    inline void UpdateControllerButtonState();
+
+    inline void ResetInputState();
+
+    [[nodiscard]] inline auto NextPlaybackEvent() -> const SDL_Event *;
+
+    inline void EndInputFrame();
 
   public:
     inline InputHandler();
@@ -51,6 +127,8 @@ class InputHandler
     void HandleInputSetup();
     void HandleInputPollEvent(SDL_Event event);
 
+    inline void ResolveActions();
+
     [[nodiscard]] inline auto IsKeyDown(SDL_Keycode keyCode) const -> bool;
     [[nodiscard]] inline auto
     IsKeyDown(const std::vector<SDL_Keycode> &keyCodes) const -> bool;
@@ -62,6 +140,13 @@ class InputHandler
     [[nodiscard]] inline auto
     IsKeyReleased(const std::vector<SDL_Keycode> &keyCodes) const -> bool;
 
+    [[nodiscard]] inline auto IsScancodeDown(SDL_Scancode scancode) const
+        -> bool;
+    [[nodiscard]] inline auto IsScancodePressed(SDL_Scancode scancode) const
+        -> bool;
+    [[nodiscard]] inline auto IsScancodeReleased(SDL_Scancode scancode) const
+        -> bool;
+
     [[nodiscard]] inline auto GetMousePosition() const -> SDL_FPoint;
 
     [[nodiscard]] inline auto IsMouseButtonDown(Uint8 buttonIndex) const
@@ -90,56 +175,249 @@ class InputHandler
     [[nodiscard]] inline auto IsControllerButtonReleased(
         const std::vector<SDL_GameControllerButton> &controllerButtons) const
         -> bool;
+
+    [[nodiscard]] inline auto GetConnectedControllers() const
+        -> const std::vector<ControllerState> &;
+    [[nodiscard]] inline auto
+    IsControllerButtonDown(SDL_JoystickID id,
+                           SDL_GameControllerButton controllerButton) const
+        -> bool;
+    [[nodiscard]] inline auto
+    IsControllerButtonPressed(SDL_JoystickID id,
+                              SDL_GameControllerButton controllerButton) const
+        -> bool;
+    [[nodiscard]] inline auto
+    IsControllerButtonReleased(SDL_JoystickID id,
+                               SDL_GameControllerButton controllerButton) const
+        -> bool;
+
+    inline void BindActionKey(size_t action, SDL_Keycode keyCode);
+    inline void BindActionMouseButton(size_t action, Uint8 buttonIndex);
+    inline void
+    BindActionControllerButton(size_t action,
+                               SDL_GameControllerButton controllerButton);
+    inline void UnbindAction(size_t action);
+    inline void ClearActionBindings();
+
+    [[nodiscard]] inline auto IsActionDown(size_t action) const -> bool;
+    [[nodiscard]] inline auto IsActionPressed(size_t action) const -> bool;
+    [[nodiscard]] inline auto IsActionReleased(size_t action) const -> bool;
+
+    inline void StartInputRecording(
+        double fixedDeltaTime = DEFAULT_INPUT_RECORDING_DELTA_TIME);
+    inline void StopInputRecording();
+    [[nodiscard]] inline auto IsRecordingInput() const -> bool;
+
+    inline void StartInputPlayback();
+    inline auto StartInputPlayback(const std::string &path) -> bool;
+    inline void StopInputPlayback();
+    [[nodiscard]] inline auto IsPlayingBackInput() const -> bool;
+
+    [[nodiscard]] inline auto GetInputRecording() -> InputRecording &;
+    [[nodiscard]] inline auto GetInputFrame() const -> Uint32;
 };
 
 InputHandler::InputHandler()
 {
-    keyState.reserve(DEFAULT_KEY_MAP_SIZE);
-    keyPressedState.reserve(DEFAULT_KEY_MAP_SIZE);
-    keyReleasedState.reserve(DEFAULT_KEY_MAP_SIZE);
+    connectedControllers.reserve(DEFAULT_CONNECTED_GAME_CONTROLLER_MAP_SIZE);
+}
+
+/**
+ * Convert a key code to the scancode it was last seen on. Key codes that
+ * aren't characters encode their scancode directly.
+ *
+ * @param keyCode Key code to convert.
+ */
+auto InputHandler::GetScancode(const SDL_Keycode keyCode) const
+    -> SDL_Scancode
+{
+    if ((keyCode & SDLK_SCANCODE_MASK) != 0)
+    {
+        return static_cast<SDL_Scancode>(keyCode & ~SDLK_SCANCODE_MASK);
+    }
 
-    mouseState.reserve(DEFAULT_MOUSE_BUTTON_MAP_SIZE);
-    mousePressedState.reserve(DEFAULT_MOUSE_BUTTON_MAP_SIZE);
-    mouseReleasedState.reserve(DEFAULT_MOUSE_BUTTON_MAP_SIZE);
+    if (keyCode >= 0 && keyCode < KEY_CODE_LOOKUP_SIZE)
+    {
+        return keyCodeScancodes[keyCode];
+    }
 
-    connectedControllers.reserve(DEFAULT_CONNECTED_GAME_CONTROLLER_MAP_SIZE);
+    return SDL_GetScancodeFromKey(keyCode);
+}
 
-    controllerButtonState.reserve(DEFAULT_GAME_CONTROLLER_BUTTON_MAP_SIZE);
-    controllerButtonPressedState.reserve(
-        DEFAULT_GAME_CONTROLLER_BUTTON_MAP_SIZE);
-    controllerButtonReleasedState.reserve(
-        DEFAULT_GAME_CONTROLLER_BUTTON_MAP_SIZE);
+auto InputHandler::FindController(const SDL_JoystickID id)
+    -> ControllerState *
+{
+    for (auto &controllerState : connectedControllers)
+    {
+        if (controllerState.id == id)
+        {
+            return &controllerState;
+        }
+    }
+
+    return nullptr;
+}
+
+auto InputHandler::FindController(const SDL_JoystickID id) const
+    -> const ControllerState *
+{
+    for (const auto &controllerState : connectedControllers)
+    {
+        if (controllerState.id == id)
+        {
+            return &controllerState;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Merge the button state of every connected controller.
+ */
+void InputHandler::UpdateControllerButtonState()
+{
+    controllerButtonState.reset();
+
+    for (const auto &controllerState : connectedControllers)
+    {
+        controllerButtonState |= controllerState.buttonState;
+    }
+}
+
+/**
+ * Release every key and button so recording or playback starts from the
+ * same state.
+ */
+void InputHandler::ResetInputState()
+{
+    keyState.reset();
+    keyPressedState.reset();
+    keyReleasedState.reset();
+
+    mousePosition = {};
+
+    mouseState.reset();
+    mousePressedState.reset();
+    mouseReleasedState.reset();
+
+    for (auto &controllerState : connectedControllers)
+    {
+        controllerState.buttonState.reset();
+        controllerState.buttonPressedState.reset();
+        controllerState.buttonReleasedState.reset();
+    }
+
+    controllerButtonState.reset();
+    controllerButtonPressedState.reset();
+    controllerButtonReleasedState.reset();
+
+    actionState.reset();
+    actionPressedState.reset();
+    actionReleasedState.reset();
+}
+
+/**
+ * Get the next recorded event for the current frame, or nullptr once every
+ * event of the frame has been played back.
+ */
+auto InputHandler::NextPlaybackEvent() -> const SDL_Event *
+{
+    const auto &events = inputRecording.GetEvents();
+
+    if (!isPlayingBackInput || playbackEventIndex >= events.size() ||
+        events[playbackEventIndex].frame > inputFrame)
+    {
+        return nullptr;
+    }
+
+    return &events[playbackEventIndex++].event;
+}
+
+/**
+ * Advance the recording or playback frame. Called once per frame after input
+ * has been handled.
+ */
+void InputHandler::EndInputFrame()
+{
+    if (!isRecordingInput && !isPlayingBackInput)
+    {
+        return;
+    }
+
+    inputFrame += 1;
+
+    if (isRecordingInput)
+    {
+        inputRecording.SetFrameCount(inputFrame);
+    }
+
+    if (isPlayingBackInput && inputFrame >= inputRecording.GetFrameCount())
+    {
+        StopInputPlayback();
+    }
 }
 
 void InputHandler::HandleInputSetup()
 {
-    keyPressedState.clear();
-    keyReleasedState.clear();
+    keyPressedState.reset();
+    keyReleasedState.reset();
+
+    mousePressedState.reset();
+    mouseReleasedState.reset();
 
-    mousePressedState.clear();
-    mouseReleasedState.clear();
+    controllerButtonPressedState.reset();
+    controllerButtonReleasedState.reset();
 
-    controllerButtonPressedState.clear();
-    controllerButtonReleasedState.clear();
+    for (auto &controllerState : connectedControllers)
+    {
+        controllerState.buttonPressedState.reset();
+        controllerState.buttonReleasedState.reset();
+    }
 }
 
 void InputHandler::HandleInputPollEvent(const SDL_Event event)
 {
     auto keyCode = event.key.keysym.sym;
+    auto scancode = event.key.keysym.scancode;
 
     auto mouseButtonIndex = event.button.button;
-    auto controllerButton = (SDL_GameControllerButton)event.cbutton.button;
+    auto controllerButton = event.cbutton.button;
+
+    if (isRecordingInput)
+    {
+        inputRecording.Add(inputFrame,
+                           SDL_GetTicks() - inputRecordingStartTicks, event);
+    }
 
     switch (event.type)
     {
     case SDL_KEYDOWN:
-        keyPressedState[keyCode] = !keyState[keyCode];
-        keyState[keyCode] = true;
+        if (keyCode >= 0 && keyCode < KEY_CODE_LOOKUP_SIZE)
+        {
+            keyCodeScancodes[keyCode] = scancode;
+        }
+
+        if (!keyState[scancode])
+        {
+            keyPressedState.set(scancode);
+        }
+
+        keyState.set(scancode);
         break;
 
     case SDL_KEYUP:
-        keyState[keyCode] = false;
-        keyReleasedState[keyCode] = true;
+        if (keyCode >= 0 && keyCode < KEY_CODE_LOOKUP_SIZE)
+        {
+            keyCodeScancodes[keyCode] = scancode;
+        }
+
+        keyState.reset(scancode);
+        keyReleasedState.set(scancode);
+        break;
+
+    case SDL_KEYMAPCHANGED:
+        keyCodeScancodes.fill(SDL_SCANCODE_UNKNOWN);
         break;
 
     case SDL_MOUSEMOTION:
@@ -148,13 +426,17 @@ void InputHandler::HandleInputPollEvent(const SDL_Event event)
         break;
 
     case SDL_MOUSEBUTTONDOWN:
-        mousePressedState[mouseButtonIndex] = !mouseState[mouseButtonIndex];
-        mouseState[mouseButtonIndex] = true;
+        if (!mouseState[mouseButtonIndex])
+        {
+            mousePressedState.set(mouseButtonIndex);
+        }
+
+        mouseState.set(mouseButtonIndex);
         break;
 
     case SDL_MOUSEBUTTONUP:
-        mouseState[mouseButtonIndex] = false;
-        mouseReleasedState[mouseButtonIndex] = true;
+        mouseState.reset(mouseButtonIndex);
+        mouseReleasedState.set(mouseButtonIndex);
         break;
 
     case SDL_CONTROLLERDEVICEADDED:
@@ -165,40 +447,70 @@ void InputHandler::HandleInputPollEvent(const SDL_Event event)
             auto id = SDL_JoystickInstanceID(
                 SDL_GameControllerGetJoystick(controller));
 
-            connectedControllers[id] = controller;
+            if (controller != nullptr && FindController(id) == nullptr)
+            {
+                connectedControllers.push_back({id, controller, {}, {}, {}});
+            }
         }
 
         break;
 
     case SDL_CONTROLLERDEVICEREMOVED:
-        for (const auto &[id, controller] : connectedControllers)
+        for (auto it = connectedControllers.begin();
+             it != connectedControllers.end(); ++it)
         {
-            if (controller != nullptr)
+            if (it->id == event.cdevice.which)
             {
-                auto controllerInstanceId = SDL_JoystickInstanceID(
-                    SDL_GameControllerGetJoystick(controller));
+                SDL_GameControllerClose(it->controller);
 
-                if (controllerInstanceId == event.cdevice.which)
-                {
-                    SDL_GameControllerClose(controller);
+                connectedControllers.erase(it);
 
-                    connectedControllers.erase(id);
+                UpdateControllerButtonState();
 
-                    break;
-                }
+                break;
             }
         }
 
         break;
 
     case SDL_CONTROLLERBUTTONDOWN:
-        controllerButtonPressedState[controllerButton] =
-            !controllerButtonState[controllerButton];
-        controllerButtonState[controllerButton] = true;
+        if (controllerButton < SDL_CONTROLLER_BUTTON_MAX)
+        {
+            if (!controllerButtonState[controllerButton])
+            {
+                controllerButtonPressedState.set(controllerButton);
+            }
+
+            if (auto *controllerState = FindController(event.cbutton.which))
+            {
+                if (!controllerState->buttonState[controllerButton])
+                {
+                    controllerState->buttonPressedState.set(controllerButton);
+                }
+
+                controllerState->buttonState.set(controllerButton);
+            }
+
+            controllerButtonState.set(controllerButton);
+        }
         break;
     case SDL_CONTROLLERBUTTONUP:
-        controllerButtonState[controllerButton] = false;
-        controllerButtonReleasedState[controllerButton] = true;
+        if (controllerButton < SDL_CONTROLLER_BUTTON_MAX)
+        {
+            if (auto *controllerState = FindController(event.cbutton.which))
+            {
+                controllerState->buttonState.reset(controllerButton);
+                controllerState->buttonReleasedState.set(controllerButton);
+
+                UpdateControllerButtonState();
+            }
+            else
+            {
+                controllerButtonState.reset(controllerButton);
+            }
+
+            controllerButtonReleasedState.set(controllerButton);
+        }
         break;
 
     default:
@@ -206,11 +518,74 @@ void InputHandler::HandleInputPollEvent(const SDL_Event event)
     }
 }
 
-auto InputHandler::IsKeyDown(const SDL_Keycode keyCode) const -> bool
+/**
+ * Update the state of every bound action from the current input state.
+ * Called once per frame after input events have been handled.
+ */
+void InputHandler::ResolveActions()
 {
-    auto result = keyState.find(keyCode);
+    auto previousActionState = actionState;
+
+    actionState.reset();
+
+    // Presses and releases seen this frame, so a press and release that
+    // both happen within one frame still trigger the action.
+    InputActionState pressedState;
+    InputActionState releasedState;
+
+    for (const auto &binding : actionBindings)
+    {
+        auto isDown = false;
+        auto isPressed = false;
+        auto isReleased = false;
+
+        switch (binding.type)
+        {
+        case InputBindingType::KEY:
+            isDown = IsKeyDown(binding.code);
+            isPressed = IsKeyPressed(binding.code);
+            isReleased = IsKeyReleased(binding.code);
+            break;
+
+        case InputBindingType::MOUSE_BUTTON:
+            isDown = mouseState[binding.code];
+            isPressed = mousePressedState[binding.code];
+            isReleased = mouseReleasedState[binding.code];
+            break;
+
+        case InputBindingType::CONTROLLER_BUTTON:
+            isDown = controllerButtonState[binding.code];
+            isPressed = controllerButtonPressedState[binding.code];
+            isReleased = controllerButtonReleasedState[binding.code];
+            break;
+        }
 
-    return result != keyState.end() && result->second;
+        if (isDown)
+        {
+            actionState.set(binding.action);
+        }
+
+        if (isPressed)
+        {
+            pressedState.set(binding.action);
+        }
+
+        if (isReleased)
+        {
+            releasedState.set(binding.action);
+        }
+    }
+
+    // Another binding for the same action may still be held, so only count
+    // a press when the action was up last frame and a release when it is
+    // up now.
+    actionPressedState = (actionState | pressedState) & ~previousActionState;
+    actionReleasedState = (previousActionState | releasedState) & ~actionState;
+}
+
+auto InputHandler::IsKeyDown(const SDL_Keycode keyCode) const -> bool
+{
+    return IsScancodeDown(GetScancode(keyCode));
 };
 
 auto InputHandler::IsKeyDown(const std::vector<SDL_Keycode> &keyCodes) const
@@ -222,16 +597,12 @@ auto InputHandler::IsKeyDown(const std::vector<SDL_Keycode> &keyCodes) const
 
 auto InputHandler::IsAnyKeyPressed() const -> bool
 {
-    auto result = keyPressedState.size() > 0;
-
-    return result;
+    return keyPressedState.any();
 };
 
 auto InputHandler::IsKeyPressed(const SDL_Keycode keyCode) const -> bool
 {
-    auto result = keyPressedState.find(keyCode);
-
-    return result != keyPressedState.end() && result->second;
+    return IsScancodePressed(GetScancode(keyCode));
 };
 
 auto InputHandler::IsKeyPressed(const std::vector<SDL_Keycode> &keyCodes) const
@@ -243,9 +614,7 @@ auto InputHandler::IsKeyPressed(const std::vector<SDL_Keycode> &keyCodes) const
 
 auto InputHandler::IsKeyReleased(const SDL_Keycode keyCode) const -> bool
 {
-    auto result = keyReleasedState.find(keyCode);
-
-    return result != keyReleasedState.end() && result->second;
+    return IsScancodeReleased(GetScancode(keyCode));
 };
 
 auto InputHandler::IsKeyReleased(const std::vector<SDL_Keycode> &keyCodes) const
@@ -255,6 +624,25 @@ auto InputHandler::IsKeyReleased(const std::vector<SDL_Keycode> &keyCodes) const
                        [this](SDL_Keycode val) { return IsKeyReleased(val); });
 };
 
+auto InputHandler::IsScancodeDown(const SDL_Scancode scancode) const -> bool
+{
+    return scancode > SDL_SCANCODE_UNKNOWN && scancode < SDL_NUM_SCANCODES &&
+           keyState[scancode];
+};
+
+auto InputHandler::IsScancodePressed(const SDL_Scancode scancode) const -> bool
+{
+    return scancode > SDL_SCANCODE_UNKNOWN && scancode < SDL_NUM_SCANCODES &&
+           keyPressedState[scancode];
+};
+
+auto InputHandler::IsScancodeReleased(const SDL_Scancode scancode) const
+    -> bool
+{
+    return scancode > SDL_SCANCODE_UNKNOWN && scancode < SDL_NUM_SCANCODES &&
+           keyReleasedState[scancode];
+};
+
 auto InputHandler::GetMousePosition() const -> SDL_FPoint
 {
     return mousePosition;
@@ -262,31 +650,25 @@ auto InputHandler::GetMousePosition() const -> SDL_FPoint
 
 auto InputHandler::IsMouseButtonDown(const Uint8 buttonIndex) const -> bool
 {
-    auto result = mouseState.find(buttonIndex);
-
-    return result != mouseState.end() && result->second;
+    return mouseState[buttonIndex];
 };
 
 auto InputHandler::IsMouseButtonPressed(const Uint8 buttonIndex) const -> bool
 {
-    auto result = mousePressedState.find(buttonIndex);
-
-    return result != mousePressedState.end() && result->second;
+    return mousePressedState[buttonIndex];
 };
 
 auto InputHandler::IsMouseButtonReleased(const Uint8 buttonIndex) const -> bool
 {
-    auto result = mouseReleasedState.find(buttonIndex);
-
-    return result != mouseReleasedState.end() && result->second;
+    return mouseReleasedState[buttonIndex];
 };
 
 auto InputHandler::IsControllerButtonDown(
     const SDL_GameControllerButton controllerButton) const -> bool
 {
-    auto result = controllerButtonState.find(controllerButton);
-
-    return result != controllerButtonState.end() && result->second;
+    return controllerButton >= 0 &&
+           controllerButton < SDL_CONTROLLER_BUTTON_MAX &&
+           controllerButtonState[controllerButton];
 };
 
 auto InputHandler::IsControllerButtonDown(
@@ -300,17 +682,15 @@ auto InputHandler::IsControllerButtonDown(
 
 auto InputHandler::IsAnyControllerButtonPressed() const -> bool
 {
-    auto result = controllerButtonPressedState.size() > 0;
-
-    return result;
+    return controllerButtonPressedState.any();
 };
 
 auto InputHandler::IsControllerButtonPressed(
     const SDL_GameControllerButton controllerButton) const -> bool
 {
-    auto result = controllerButtonPressedState.find(controllerButton);
-
-    return result != controllerButtonPressedState.end() && result->second;
+    return controllerButton >= 0 &&
+           controllerButton < SDL_CONTROLLER_BUTTON_MAX &&
+           controllerButtonPressedState[controllerButton];
 };
 
 auto InputHandler::IsControllerButtonPressed(
@@ -325,9 +705,9 @@ auto InputHandler::IsControllerButtonPressed(
 auto InputHandler::IsControllerButtonReleased(
     const SDL_GameControllerButton controllerButton) const -> bool
 {
-    auto result = controllerButtonReleasedState.find(controllerButton);
-
-    return result != controllerButtonReleasedState.end() && result->second;
+    return controllerButton >= 0 &&
+           controllerButton < SDL_CONTROLLER_BUTTON_MAX &&
+           controllerButtonReleasedState[controllerButton];
 };
 
 auto InputHandler::IsControllerButtonReleased(
@@ -339,4 +719,194 @@ auto InputHandler::IsControllerButtonReleased(
                        { return IsControllerButtonReleased(val); });
 };
 
+auto InputHandler::GetConnectedControllers() const
+    -> const std::vector<ControllerState> &
+{
+    return connectedControllers;
+};
+
+auto InputHandler::IsControllerButtonDown(
+    const SDL_JoystickID id,
+    const SDL_GameControllerButton controllerButton) const -> bool
+{
+    const auto *controllerState = FindController(id);
+
+    return controllerState != nullptr && controllerButton >= 0 &&
+           controllerButton < SDL_CONTROLLER_BUTTON_MAX &&
+           controllerState->buttonState[controllerButton];
+};
+
+auto InputHandler::IsControllerButtonPressed(
+    const SDL_JoystickID id,
+    const SDL_GameControllerButton controllerButton) const -> bool
+{
+    const auto *controllerState = FindController(id);
+
+    return controllerState != nullptr && controllerButton >= 0 &&
+           controllerButton < SDL_CONTROLLER_BUTTON_MAX &&
+           controllerState->buttonPressedState[controllerButton];
+};
+
+auto InputHandler::IsControllerButtonReleased(
+    const SDL_JoystickID id,
+    const SDL_GameControllerButton controllerButton) const -> bool
+{
+    const auto *controllerState = FindController(id);
+
+    return controllerState != nullptr && controllerButton >= 0 &&
+           controllerButton < SDL_CONTROLLER_BUTTON_MAX &&
+           controllerState->buttonReleasedState[controllerButton];
+};
+
+/**
+ * Bind a key to an action. An action can have any number of bindings.
+ *
+ * @param action Action index, less than MAX_INPUT_ACTIONS.
+ * @param keyCode Key code to bind.
+ */
+void InputHandler::BindActionKey(const size_t action, const SDL_Keycode keyCode)
+{
+    if (action < MAX_INPUT_ACTIONS)
+    {
+        actionBindings.push_back({action, InputBindingType::KEY, keyCode});
+    }
+}
+
+/**
+ * Bind a mouse button to an action.
+ *
+ * @param action Action index, less than MAX_INPUT_ACTIONS.
+ * @param buttonIndex Mouse button to bind.
+ */
+void InputHandler::BindActionMouseButton(const size_t action,
+                                         const Uint8 buttonIndex)
+{
+    if (action < MAX_INPUT_ACTIONS)
+    {
+        actionBindings.push_back(
+            {action, InputBindingType::MOUSE_BUTTON, buttonIndex});
+    }
+}
+
+/**
+ * Bind a controller button on any connected controller to an action.
+ *
+ * @param action Action index, less than MAX_INPUT_ACTIONS.
+ * @param controllerButton Controller button to bind.
+ */
+void InputHandler::BindActionControllerButton(
+    const size_t action, const SDL_GameControllerButton controllerButton)
+{
+    if (action < MAX_INPUT_ACTIONS && controllerButton >= 0 &&
+        controllerButton < SDL_CONTROLLER_BUTTON_MAX)
+    {
+        actionBindings.push_back(
+            {action, InputBindingType::CONTROLLER_BUTTON, controllerButton});
+    }
+}
+
+void InputHandler::UnbindAction(const size_t action)
+{
+    actionBindings.erase(std::remove_if(actionBindings.begin(),
+                                        actionBindings.end(),
+                                        [action](const InputBinding &binding)
+                                        { return binding.action == action; }),
+                         actionBindings.end());
+}
+
+void InputHandler::ClearActionBindings() { actionBindings.clear(); }
+
+auto InputHandler::IsActionDown(const size_t action) const -> bool
+{
+    return action < MAX_INPUT_ACTIONS && actionState[action];
+};
+
+auto InputHandler::IsActionPressed(const size_t action) const -> bool
+{
+    return action < MAX_INPUT_ACTIONS && actionPressedState[action];
+};
+
+auto InputHandler::IsActionReleased(const size_t action) const -> bool
+{
+    return action < MAX_INPUT_ACTIONS && actionReleasedState[action];
+};
+
+/**
+ * Record every input event handled from the next frame on, replacing any
+ * previous recording.
+ *
+ * @param fixedDeltaTime Delta time the game steps with while recording and
+ * during playback.
+ */
+void InputHandler::StartInputRecording(const double fixedDeltaTime)
+{
+    StopInputPlayback();
+
+    ResetInputState();
+
+    inputRecording.Clear();
+    inputRecording.SetFixedDeltaTime(fixedDeltaTime);
+
+    inputFrame = 0;
+
+    inputRecordingStartTicks = SDL_GetTicks();
+
+    isRecordingInput = true;
+}
+
+void InputHandler::StopInputRecording() { isRecordingInput = false; }
+
+auto InputHandler::IsRecordingInput() const -> bool
+{
+    return isRecordingInput;
+}
+
+/**
+ * Replay the current recording in place of polled input events, one
+ * recorded frame per frame. Playback stops after the last recorded frame.
+ */
+void InputHandler::StartInputPlayback()
+{
+    StopInputRecording();
+
+    ResetInputState();
+
+    inputFrame = 0;
+
+    playbackEventIndex = 0;
+
+    isPlayingBackInput = inputRecording.GetFrameCount() > 0;
+}
+
+/**
+ * Load a recording from a file and replay it.
+ *
+ * @param path Input recording file.
+ */
+auto InputHandler::StartInputPlayback(const std::string &path) -> bool
+{
+    if (!inputRecording.Load(path))
+    {
+        return false;
+    }
+
+    StartInputPlayback();
+
+    return true;
+}
+
+void InputHandler::StopInputPlayback() { isPlayingBackInput = false; }
+
+auto InputHandler::IsPlayingBackInput() const -> bool
+{
+    return isPlayingBackInput;
+}
+
+auto InputHandler::GetInputRecording() -> InputRecording &
+{
+    return inputRecording;
+}
+
+auto InputHandler::GetInputFrame() const -> Uint32 { return inputFrame; }
+
 } // namespace HandcrankEngine
@@ -0,0 +1,433 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL.h>
+
+namespace HandcrankEngine
+{
+
+inline const char INPUT_RECORDING_MAGIC[4] = {'H', 'C', 'I', 'R'};
+
+inline const Uint32 INPUT_RECORDING_VERSION = 1;
+
+inline const double DEFAULT_INPUT_RECORDING_DELTA_TIME = 1.0 / 60;
+
+struct RecordedInputEvent
+{
+    Uint32 frame;
+
+    Uint32 timestamp;
+
+    SDL_Event event;
+};
+
+/**
+ * A recorded stream of input events, each tagged with the frame it was
+ * handled on, that can be written to and read from a compact binary file.
+ *
+ * File layout, all values little endian: the magic "HCIR", a version, the
+ * fixed delta time to play back with, the frame and event counts, then for
+ * each event its frame, timestamp, type and only the fields input handling
+ * reads for that type.
+ */
+class InputRecording
+{
+  private:
+    std::vector<RecordedInputEvent> events;
+
+    Uint32 frameCount = 0;
+
+    double fixedDeltaTime = DEFAULT_INPUT_RECORDING_DELTA_TIME;
+
+    static void WriteValue(std::vector<char> &buffer, uint64_t value,
+                           size_t size)
+    {
+        for (size_t i = 0; i < size; i += 1)
+        {
+            buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+        }
+    }
+
+    static auto ReadValue(const std::vector<char> &buffer, size_t &offset,
+                          size_t size, uint64_t &value) -> bool
+    {
+        if (offset + size > buffer.size())
+        {
+            return false;
+        }
+
+        value = 0;
+
+        for (size_t i = 0; i < size; i += 1)
+        {
+            value |= static_cast<uint64_t>(
+                         static_cast<unsigned char>(buffer[offset + i]))
+                     << (i * 8);
+        }
+
+        offset += size;
+
+        return true;
+    }
+
+  public:
+    /**
+     * Check if an event is one that input handling reacts to and can be
+     * recorded.
+     *
+     * @param event Event to check.
+     */
+    [[nodiscard]] static auto IsRecordable(const SDL_Event &event) -> bool
+    {
+        switch (event.type)
+        {
+        case SDL_QUIT:
+        case SDL_WINDOWEVENT:
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_KEYMAPCHANGED:
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        case SDL_CONTROLLERDEVICEADDED:
+        case SDL_CONTROLLERDEVICEREMOVED:
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    [[nodiscard]] auto GetEvents() const
+        -> const std::vector<RecordedInputEvent> &
+    {
+        return events;
+    }
+
+    [[nodiscard]] auto GetFrameCount() const -> Uint32 { return frameCount; }
+
+    void SetFrameCount(Uint32 frameCount) { this->frameCount = frameCount; }
+
+    [[nodiscard]] auto GetFixedDeltaTime() const -> double
+    {
+        return fixedDeltaTime;
+    }
+
+    void SetFixedDeltaTime(double fixedDeltaTime)
+    {
+        this->fixedDeltaTime = fixedDeltaTime;
+    }
+
+    /**
+     * Add an event. Events that input handling doesn't react to are ignored.
+     *
+     * @param frame Frame the event was handled on.
+     * @param timestamp Milliseconds since recording started.
+     * @param event Event to add.
+     */
+    void Add(Uint32 frame, Uint32 timestamp, const SDL_Event &event)
+    {
+        if (IsRecordable(event))
+        {
+            events.push_back({frame, timestamp, event});
+        }
+    }
+
+    void Clear()
+    {
+        events.clear();
+
+        frameCount = 0;
+    }
+
+    /**
+     * Write the recording to a file.
+     *
+     * @param path File to write to.
+     */
+    auto Save(const std::string &path) const -> bool
+    {
+        std::vector<char> buffer(std::begin(INPUT_RECORDING_MAGIC),
+                                 std::end(INPUT_RECORDING_MAGIC));
+
+        uint64_t fixedDeltaTimeBits = 0;
+
+        std::memcpy(&fixedDeltaTimeBits, &fixedDeltaTime,
+                    sizeof(fixedDeltaTimeBits));
+
+        WriteValue(buffer, INPUT_RECORDING_VERSION, 4);
+        WriteValue(buffer, fixedDeltaTimeBits, 8);
+        WriteValue(buffer, frameCount, 4);
+        WriteValue(buffer, events.size(), 4);
+
+        for (const auto &[frame, timestamp, event] : events)
+        {
+            WriteValue(buffer, frame, 4);
+            WriteValue(buffer, timestamp, 4);
+            WriteValue(buffer, event.type, 4);
+
+            switch (event.type)
+            {
+            case SDL_WINDOWEVENT:
+                WriteValue(buffer, event.window.event, 1);
+                WriteValue(buffer, static_cast<Uint32>(event.window.data1), 4);
+                WriteValue(buffer, static_cast<Uint32>(event.window.data2), 4);
+                break;
+
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+                WriteValue(buffer, event.key.keysym.scancode, 4);
+                WriteValue(buffer, static_cast<Uint32>(event.key.keysym.sym),
+                           4);
+                WriteValue(buffer, event.key.keysym.mod, 2);
+                WriteValue(buffer, event.key.repeat, 1);
+                break;
+
+            case SDL_MOUSEMOTION:
+                WriteValue(buffer, static_cast<Uint32>(event.motion.x), 4);
+                WriteValue(buffer, static_cast<Uint32>(event.motion.y), 4);
+                break;
+
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+                WriteValue(buffer, event.button.button, 1);
+                WriteValue(buffer, static_cast<Uint32>(event.button.x), 4);
+                WriteValue(buffer, static_cast<Uint32>(event.button.y), 4);
+                break;
+
+            case SDL_CONTROLLERDEVICEADDED:
+            case SDL_CONTROLLERDEVICEREMOVED:
+                WriteValue(buffer, static_cast<Uint32>(event.cdevice.which),
+                           4);
+                break;
+
+            case SDL_CONTROLLERBUTTONDOWN:
+            case SDL_CONTROLLERBUTTONUP:
+                WriteValue(buffer, static_cast<Uint32>(event.cbutton.which),
+                           4);
+                WriteValue(buffer, event.cbutton.button, 1);
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        std::ofstream file(path, std::ios::binary);
+
+        if (!file)
+        {
+            SDL_Log("Failed to write input recording to %s", path.c_str());
+
+            return false;
+        }
+
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * Replace the recording with one read from a file.
+     *
+     * @param path File to read from.
+     */
+    auto Load(const std::string &path) -> bool
+    {
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file)
+        {
+            SDL_Log("Failed to read input recording from %s", path.c_str());
+
+            return false;
+        }
+
+        std::vector<char> buffer((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+
+        if (buffer.size() < sizeof(INPUT_RECORDING_MAGIC) ||
+            std::memcmp(buffer.data(), INPUT_RECORDING_MAGIC,
+                        sizeof(INPUT_RECORDING_MAGIC)) != 0)
+        {
+            SDL_Log("%s is not an input recording", path.c_str());
+
+            return false;
+        }
+
+        size_t offset = sizeof(INPUT_RECORDING_MAGIC);
+
+        uint64_t version = 0;
+        uint64_t fixedDeltaTimeBits = 0;
+        uint64_t loadedFrameCount = 0;
+        uint64_t eventCount = 0;
+
+        if (!ReadValue(buffer, offset, 4, version) ||
+            version != INPUT_RECORDING_VERSION ||
+            !ReadValue(buffer, offset, 8, fixedDeltaTimeBits) ||
+            !ReadValue(buffer, offset, 4, loadedFrameCount) ||
+            !ReadValue(buffer, offset, 4, eventCount))
+        {
+            SDL_Log("Unsupported input recording %s", path.c_str());
+
+            return false;
+        }
+
+        std::vector<RecordedInputEvent> loadedEvents;
+
+        // Every event has at least a frame, timestamp and type, so a corrupt
+        // count can't reserve more than the file could hold.
+        const size_t eventHeaderSize = 12;
+
+        loadedEvents.reserve(static_cast<size_t>(std::min<uint64_t>(
+            eventCount, (buffer.size() - offset) / eventHeaderSize)));
+
+        for (uint64_t i = 0; i < eventCount; i += 1)
+        {
+            uint64_t frame = 0;
+            uint64_t timestamp = 0;
+            uint64_t type = 0;
+
+            if (!ReadValue(buffer, offset, 4, frame) ||
+                !ReadValue(buffer, offset, 4, timestamp) ||
+                !ReadValue(buffer, offset, 4, type))
+            {
+                SDL_Log("Truncated input recording %s", path.c_str());
+
+                return false;
+            }
+
+            SDL_Event event{};
+
+            event.type = static_cast<Uint32>(type);
+
+            uint64_t a = 0;
+            uint64_t b = 0;
+            uint64_t c = 0;
+            uint64_t d = 0;
+
+            auto isValid = true;
+
+            switch (event.type)
+            {
+            case SDL_WINDOWEVENT:
+                isValid = ReadValue(buffer, offset, 1, a) &&
+                          ReadValue(buffer, offset, 4, b) &&
+                          ReadValue(buffer, offset, 4, c);
+
+                event.window.timestamp = static_cast<Uint32>(timestamp);
+                event.window.event = static_cast<Uint8>(a);
+                event.window.data1 = static_cast<Sint32>(b);
+                event.window.data2 = static_cast<Sint32>(c);
+                break;
+
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+                isValid = ReadValue(buffer, offset, 4, a) &&
+                          ReadValue(buffer, offset, 4, b) &&
+                          ReadValue(buffer, offset, 2, c) &&
+                          ReadValue(buffer, offset, 1, d) &&
+                          a < SDL_NUM_SCANCODES;
+
+                event.key.timestamp = static_cast<Uint32>(timestamp);
+                event.key.state =
+                    event.type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+                event.key.keysym.scancode = static_cast<SDL_Scancode>(a);
+                event.key.keysym.sym = static_cast<SDL_Keycode>(b);
+                event.key.keysym.mod = static_cast<Uint16>(c);
+                event.key.repeat = static_cast<Uint8>(d);
+                break;
+
+            case SDL_MOUSEMOTION:
+                isValid = ReadValue(buffer, offset, 4, a) &&
+                          ReadValue(buffer, offset, 4, b);
+
+                event.motion.timestamp = static_cast<Uint32>(timestamp);
+                event.motion.x = static_cast<Sint32>(a);
+                event.motion.y = static_cast<Sint32>(b);
+                break;
+
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+                isValid = ReadValue(buffer, offset, 1, a) &&
+                          ReadValue(buffer, offset, 4, b) &&
+                          ReadValue(buffer, offset, 4, c) && a != 0;
+
+                event.button.timestamp = static_cast<Uint32>(timestamp);
+                event.button.state = event.type == SDL_MOUSEBUTTONDOWN
+                                         ? SDL_PRESSED
+                                         : SDL_RELEASED;
+                event.button.button = static_cast<Uint8>(a);
+                event.button.x = static_cast<Sint32>(b);
+                event.button.y = static_cast<Sint32>(c);
+                break;
+
+            case SDL_CONTROLLERDEVICEADDED:
+            case SDL_CONTROLLERDEVICEREMOVED:
+                isValid = ReadValue(buffer, offset, 4, a);
+
+                event.cdevice.timestamp = static_cast<Uint32>(timestamp);
+                event.cdevice.which = static_cast<Sint32>(a);
+                break;
+
+            case SDL_CONTROLLERBUTTONDOWN:
+            case SDL_CONTROLLERBUTTONUP:
+                isValid = ReadValue(buffer, offset, 4, a) &&
+                          ReadValue(buffer, offset, 1, b) &&
+                          b < SDL_CONTROLLER_BUTTON_MAX;
+
+                event.cbutton.timestamp = static_cast<Uint32>(timestamp);
+                event.cbutton.state = event.type == SDL_CONTROLLERBUTTONDOWN
+                                          ? SDL_PRESSED
+                                          : SDL_RELEASED;
+                event.cbutton.which = static_cast<SDL_JoystickID>(a);
+                event.cbutton.button = static_cast<Uint8>(b);
+                break;
+
+            default:
+                break;
+            }
+
+            if (!isValid)
+            {
+                SDL_Log("Truncated or invalid input recording %s",
+                        path.c_str());
+
+                return false;
+            }
+
+            loadedEvents.push_back({static_cast<Uint32>(frame),
+                                    static_cast<Uint32>(timestamp), event});
+        }
+
+        std::memcpy(&fixedDeltaTime, &fixedDeltaTimeBits,
+                    sizeof(fixedDeltaTime));
+
+        frameCount = static_cast<Uint32>(loadedFrameCount);
+
+        events = std::move(loadedEvents);
+
+        return true;
+    }
+};
+
+} // namespace HandcrankEngine
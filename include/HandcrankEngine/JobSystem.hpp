@@ -0,0 +1,572 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace HandcrankEngine
+{
+
+inline const size_t JOB_QUEUE_CAPACITY = 4096;
+
+inline const size_t JOB_FUNCTION_INLINE_SIZE = 48;
+
+inline const size_t JOB_POOL_BLOCK_SIZE = 256;
+
+/**
+ * Counts outstanding jobs. Pass one to JobSystem::Submit and wait on it
+ * with JobSystem::Wait to express dependencies between groups of jobs.
+ */
+class JobCounter
+{
+  private:
+    std::atomic<int> count{0};
+
+  public:
+    void Increment(int amount = 1)
+    {
+        count.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void Decrement() { count.fetch_sub(1, std::memory_order_acq_rel); }
+
+    [[nodiscard]] auto IsComplete() const -> bool
+    {
+        return count.load(std::memory_order_acquire) == 0;
+    }
+};
+
+/**
+ * Type-erased job callable. Callables that fit are stored inline so
+ * submitting a job doesn't allocate, larger ones fall back to the heap.
+ */
+class JobFunction
+{
+  private:
+    alignas(std::max_align_t)
+        std::array<unsigned char, JOB_FUNCTION_INLINE_SIZE> storage{};
+
+    void *target = nullptr;
+
+    void (*invoke)(void *) = nullptr;
+    void (*destroy)(void *) = nullptr;
+
+  public:
+    JobFunction() = default;
+
+    JobFunction(const JobFunction &) = delete;
+    auto operator=(const JobFunction &) -> JobFunction & = delete;
+
+    ~JobFunction() { Reset(); }
+
+    template <typename Function> void Set(Function &&function)
+    {
+        using Callable = std::decay_t<Function>;
+
+        Reset();
+
+        if constexpr (sizeof(Callable) <= JOB_FUNCTION_INLINE_SIZE &&
+                      alignof(Callable) <= alignof(std::max_align_t))
+        {
+            target = new (storage.data())
+                Callable(std::forward<Function>(function));
+
+            destroy = [](void *callable)
+            { static_cast<Callable *>(callable)->~Callable(); };
+        }
+        else
+        {
+            target = new Callable(std::forward<Function>(function));
+
+            destroy = [](void *callable)
+            { delete static_cast<Callable *>(callable); };
+        }
+
+        invoke = [](void *callable) { (*static_cast<Callable *>(callable))(); };
+    }
+
+    void operator()() { invoke(target); }
+
+    void Reset()
+    {
+        if (destroy != nullptr)
+        {
+            destroy(target);
+        }
+
+        target = nullptr;
+        invoke = nullptr;
+        destroy = nullptr;
+    }
+};
+
+struct Job
+{
+    JobFunction function;
+
+    JobCounter *counter = nullptr;
+
+    Job *next = nullptr;
+};
+
+/**
+ * Fixed capacity Chase-Lev deque. The owning thread pushes and pops from the
+ * bottom while any other thread may steal from the top without locking.
+ */
+class WorkStealingQueue
+{
+  private:
+    static constexpr size_t MASK = JOB_QUEUE_CAPACITY - 1;
+
+    static_assert((JOB_QUEUE_CAPACITY & MASK) == 0,
+                  "JOB_QUEUE_CAPACITY must be a power of two");
+
+    std::array<std::atomic<Job *>, JOB_QUEUE_CAPACITY> buffer{};
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+
+  public:
+    auto Push(Job *job) -> bool
+    {
+        auto b = bottom.load(std::memory_order_relaxed);
+        auto t = top.load(std::memory_order_acquire);
+
+        if (b - t >= static_cast<int64_t>(JOB_QUEUE_CAPACITY))
+        {
+            return false;
+        }
+
+        buffer[b & MASK].store(job, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_release);
+
+        bottom.store(b + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    auto Pop() -> Job *
+    {
+        auto b = bottom.load(std::memory_order_relaxed) - 1;
+
+        bottom.store(b, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto t = top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            bottom.store(b + 1, std::memory_order_relaxed);
+
+            return nullptr;
+        }
+
+        auto *job = buffer[b & MASK].load(std::memory_order_relaxed);
+
+        if (t == b)
+        {
+            if (!top.compare_exchange_strong(t, t + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    auto Steal() -> Job *
+    {
+        auto t = top.load(std::memory_order_acquire);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+        {
+            return nullptr;
+        }
+
+        auto *job = buffer[t & MASK].load(std::memory_order_relaxed);
+
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        return job;
+    }
+};
+
+/**
+ * Work-stealing job scheduler. The thread that creates the job system owns
+ * queue 0 and helps run jobs while it waits, the remaining queues belong to
+ * background workers. Jobs submitted from threads outside the job system go
+ * through a shared injection queue.
+ */
+class JobSystem
+{
+  private:
+    std::vector<std::unique_ptr<WorkStealingQueue>> queues;
+
+    std::vector<std::thread> workers;
+
+    std::mutex injectionMutex;
+    std::deque<Job *> injectionQueue;
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+
+    std::atomic<int> pendingJobs{0};
+    std::atomic<int> sleepingWorkers{0};
+
+    std::atomic<bool> quit{false};
+
+    // Jobs are recycled through a free list instead of allocated per submit.
+    std::mutex jobPoolMutex;
+    std::vector<std::unique_ptr<Job[]>> jobBlocks;
+    Job *freeJobs = nullptr;
+
+    inline static thread_local JobSystem *currentJobSystem = nullptr;
+    inline static thread_local size_t currentQueueIndex = 0;
+
+    inline static thread_local bool isRunningJob = false;
+
+  public:
+    /**
+     * Create a job system.
+     *
+     * @param threadCount Total number of threads that run jobs, including the
+     * calling thread. Defaults to the hardware concurrency.
+     */
+    explicit JobSystem(size_t threadCount = GetDefaultThreadCount())
+    {
+        threadCount = std::max<size_t>(threadCount, 1);
+
+        queues.reserve(threadCount);
+
+        for (size_t i = 0; i < threadCount; i += 1)
+        {
+            queues.emplace_back(std::make_unique<WorkStealingQueue>());
+        }
+
+        currentJobSystem = this;
+        currentQueueIndex = 0;
+
+        workers.reserve(threadCount - 1);
+
+        for (size_t i = 1; i < threadCount; i += 1)
+        {
+            workers.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+
+    JobSystem(const JobSystem &) = delete;
+    auto operator=(const JobSystem &) -> JobSystem & = delete;
+
+    ~JobSystem()
+    {
+        quit.store(true);
+
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+
+        sleepCondition.notify_all();
+
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+
+        while (auto *job = FindJob(0))
+        {
+            RunJob(job);
+        }
+
+        if (currentJobSystem == this)
+        {
+            currentJobSystem = nullptr;
+        }
+    }
+
+    [[nodiscard]] static auto GetDefaultThreadCount() -> size_t
+    {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        return 1;
+#else
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+#endif
+    }
+
+    /**
+     * Check if the calling thread is inside a job. Renderer, TTF and
+     * resource cache calls are not thread safe and must not be made from a
+     * job.
+     */
+    [[nodiscard]] static auto IsRunningJob() -> bool { return isRunningJob; }
+
+    [[nodiscard]] auto GetThreadCount() const -> size_t
+    {
+        return queues.size();
+    }
+
+    /**
+     * Queue a job.
+     *
+     * @param function Work to run on any thread in the job system.
+     * @param counter Optional counter that is incremented now and decremented
+     * once the job has run.
+     */
+    template <typename Function>
+    void Submit(Function &&function, JobCounter *counter = nullptr)
+    {
+        if (counter != nullptr)
+        {
+            counter->Increment();
+        }
+
+        auto *job = AllocateJob();
+
+        job->function.Set(std::forward<Function>(function));
+        job->counter = counter;
+
+        if (currentJobSystem != this ||
+            !queues[currentQueueIndex]->Push(job))
+        {
+            std::lock_guard<std::mutex> lock(injectionMutex);
+
+            injectionQueue.push_back(job);
+        }
+
+        pendingJobs.fetch_add(1);
+
+        if (sleepingWorkers.load() > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+            }
+
+            sleepCondition.notify_one();
+        }
+    }
+
+    /**
+     * Run jobs until counter reaches zero. Threads outside the job system
+     * have no queue of their own, so they help by stealing from every worker
+     * queue and taking jobs from the injection queue.
+     */
+    void Wait(const JobCounter &counter)
+    {
+        auto queueIndex = currentJobSystem == this ? currentQueueIndex
+                                                   : queues.size();
+
+        while (!counter.IsComplete())
+        {
+            if (auto *job = FindJob(queueIndex))
+            {
+                RunJob(job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * Split [0, count) into batches and run function over every batch in
+     * parallel, returning once all batches have completed.
+     *
+     * @param count Number of items.
+     * @param batchSize Items per job. 0 picks a size that gives every thread
+     * a few batches.
+     * @param function Called with the start and end index of each batch.
+     */
+    void ParallelFor(size_t count, size_t batchSize,
+                     const std::function<void(size_t, size_t)> &function)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (batchSize == 0)
+        {
+            batchSize = std::max<size_t>(count / (queues.size() * 4), 1);
+        }
+
+        if (queues.size() == 1 || count <= batchSize)
+        {
+            function(0, count);
+
+            return;
+        }
+
+        JobCounter counter;
+
+        for (size_t start = batchSize; start < count; start += batchSize)
+        {
+            auto end = std::min(start + batchSize, count);
+
+            Submit([&function, start, end] { function(start, end); },
+                   &counter);
+        }
+
+        function(0, batchSize);
+
+        Wait(counter);
+    }
+
+  private:
+    void WorkerLoop(size_t queueIndex)
+    {
+        currentJobSystem = this;
+        currentQueueIndex = queueIndex;
+
+        while (!quit.load())
+        {
+            if (auto *job = FindJob(queueIndex))
+            {
+                RunJob(job);
+
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+
+            sleepingWorkers.fetch_add(1);
+
+            sleepCondition.wait(
+                lock, [this] { return quit.load() || pendingJobs.load() > 0; });
+
+            sleepingWorkers.fetch_sub(1);
+        }
+    }
+
+    auto FindJob(size_t queueIndex) -> Job *
+    {
+        Job *job = nullptr;
+
+        if (queueIndex < queues.size())
+        {
+            job = queues[queueIndex]->Pop();
+        }
+
+        for (size_t i = 1; job == nullptr && i < queues.size() + 1; i += 1)
+        {
+            auto victim = (queueIndex + i) % queues.size();
+
+            if (victim != queueIndex)
+            {
+                job = queues[victim]->Steal();
+            }
+        }
+
+        if (job == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(injectionMutex);
+
+            if (!injectionQueue.empty())
+            {
+                job = injectionQueue.front();
+
+                injectionQueue.pop_front();
+            }
+        }
+
+        if (job != nullptr)
+        {
+            pendingJobs.fetch_sub(1);
+        }
+
+        return job;
+    }
+
+    auto AllocateJob() -> Job *
+    {
+        std::lock_guard<std::mutex> lock(jobPoolMutex);
+
+        if (freeJobs == nullptr)
+        {
+            auto block = std::make_unique<Job[]>(JOB_POOL_BLOCK_SIZE);
+
+            for (size_t i = 0; i < JOB_POOL_BLOCK_SIZE; i += 1)
+            {
+                block[i].next = freeJobs;
+
+                freeJobs = &block[i];
+            }
+
+            jobBlocks.push_back(std::move(block));
+        }
+
+        auto *job = freeJobs;
+
+        freeJobs = job->next;
+
+        return job;
+    }
+
+    void ReleaseJob(Job *job)
+    {
+        std::lock_guard<std::mutex> lock(jobPoolMutex);
+
+        job->next = freeJobs;
+
+        freeJobs = job;
+    }
+
+    void RunJob(Job *job)
+    {
+        auto wasRunningJob = isRunningJob;
+
+        isRunningJob = true;
+
+        job->function();
+
+        isRunningJob = wasRunningJob;
+
+        // Release captures before the counter lets a waiter continue.
+        job->function.Reset();
+
+        auto *counter = job->counter;
+
+        ReleaseJob(job);
+
+        if (counter != nullptr)
+        {
+            counter->Decrement();
+        }
+    }
+};
+
+} // namespace HandcrankEngine
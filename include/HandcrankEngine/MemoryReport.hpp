@@ -0,0 +1,214 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <SDL.h>
+
+#include "Utilities.hpp"
+
+namespace HandcrankEngine
+{
+
+inline const char *const DEFAULT_MEMORY_REPORT_OUTPUT_PATH =
+    "handcrank-memory.json";
+
+/**
+ * Render objects of a single class in a memory report.
+ */
+struct MemoryReportClass
+{
+    const std::type_info *type = nullptr;
+
+    size_t count = 0;
+
+    // Size of the objects themselves, as reported by GetInstanceSize.
+    size_t instanceBytes = 0;
+
+    // Memory the objects own outside of themselves, as reported by
+    // GetResourceBytes.
+    size_t resourceBytes = 0;
+};
+
+/**
+ * Estimated memory held by the engine, filled by Game::GetMemoryReport.
+ * Texture sizes are width * height * bytes per pixel of their format, fonts
+ * are counted by the size of the font file and sounds by their decoded PCM
+ * data, so the totals are estimates rather than exact driver or heap usage.
+ */
+struct MemoryReport
+{
+    size_t textureCacheCount = 0;
+    size_t textureCacheBytes = 0;
+
+    size_t textureAtlasPageCount = 0;
+    size_t textureAtlasBytes = 0;
+
+    size_t fontCacheCount = 0;
+    size_t fontCacheBytes = 0;
+
+    size_t glyphAtlasPageCount = 0;
+    size_t glyphAtlasBytes = 0;
+
+    size_t audioSFXCacheCount = 0;
+    size_t audioSFXCacheBytes = 0;
+
+    size_t audioMusicCacheCount = 0;
+    size_t audioMusicCacheBytes = 0;
+
+    size_t frameArenaBytes = 0;
+
+    size_t objectCount = 0;
+    size_t objectInstanceBytes = 0;
+    size_t objectResourceBytes = 0;
+
+    // Sorted from most to least memory. Reused between reports so filling
+    // the same report every frame doesn't allocate once every class has
+    // been seen.
+    std::vector<MemoryReportClass> classes;
+
+    /**
+     * Reset every total and count, keeping the capacity of the class list.
+     */
+    void Clear()
+    {
+        auto reusedClasses = std::move(classes);
+
+        *this = MemoryReport();
+
+        classes = std::move(reusedClasses);
+
+        classes.clear();
+    }
+
+    /**
+     * Add a render object to the totals of its class.
+     *
+     * @param type Class of the object.
+     * @param instanceBytes Size of the object.
+     * @param resourceBytes Memory the object owns outside of itself.
+     */
+    void AddObject(const std::type_info &type, size_t instanceBytes,
+                   size_t resourceBytes)
+    {
+        objectCount += 1;
+        objectInstanceBytes += instanceBytes;
+        objectResourceBytes += resourceBytes;
+
+        auto match = std::find_if(classes.begin(), classes.end(),
+                                  [&type](const MemoryReportClass &entry)
+                                  { return *entry.type == type; });
+
+        if (match == classes.end())
+        {
+            classes.push_back({&type, 0, 0, 0});
+
+            match = std::prev(classes.end());
+        }
+
+        match->count += 1;
+        match->instanceBytes += instanceBytes;
+        match->resourceBytes += resourceBytes;
+    }
+
+    /**
+     * Sort classes from most to least memory.
+     */
+    void SortClasses()
+    {
+        std::sort(classes.begin(), classes.end(),
+                  [](const MemoryReportClass &a, const MemoryReportClass &b)
+                  {
+                      return a.instanceBytes + a.resourceBytes >
+                             b.instanceBytes + b.resourceBytes;
+                  });
+    }
+
+    /**
+     * Sum of every category. Texture and glyph atlas pages are counted once,
+     * the regions packed into them are not counted again.
+     */
+    [[nodiscard]] auto GetTotalBytes() const -> size_t
+    {
+        return textureCacheBytes + textureAtlasBytes + fontCacheBytes +
+               glyphAtlasBytes + audioSFXCacheBytes + audioMusicCacheBytes +
+               frameArenaBytes + objectInstanceBytes + objectResourceBytes;
+    }
+
+    /**
+     * Write the report as JSON.
+     *
+     * @param path File path to write to.
+     */
+    auto Dump(const std::string &path) const -> bool
+    {
+        std::ofstream file(path);
+
+        if (!file)
+        {
+            SDL_Log("Failed to write memory report to %s", path.c_str());
+
+            return false;
+        }
+
+        auto writeCategory = [&file](const char *name, size_t count,
+                                     size_t bytes)
+        {
+            file << "    \"" << name << "\": {\"count\": " << count
+                 << ", \"bytes\": " << bytes << "},\n";
+        };
+
+        file << "{\n  \"totalBytes\": " << GetTotalBytes() << ",\n";
+
+        file << "  \"resources\": {\n";
+
+        writeCategory("textureCache", textureCacheCount, textureCacheBytes);
+        writeCategory("textureAtlas", textureAtlasPageCount,
+                      textureAtlasBytes);
+        writeCategory("fontCache", fontCacheCount, fontCacheBytes);
+        writeCategory("glyphAtlas", glyphAtlasPageCount, glyphAtlasBytes);
+        writeCategory("audioSFXCache", audioSFXCacheCount, audioSFXCacheBytes);
+        writeCategory("audioMusicCache", audioMusicCacheCount,
+                      audioMusicCacheBytes);
+
+        file << "    \"frameArena\": {\"bytes\": " << frameArenaBytes
+             << "}\n  },\n";
+
+        file << "  \"objects\": {\"count\": " << objectCount
+             << ", \"instanceBytes\": " << objectInstanceBytes
+             << ", \"resourceBytes\": " << objectResourceBytes << "},\n";
+
+        file << "  \"classes\": [\n";
+
+        for (size_t i = 0; i < classes.size(); i += 1)
+        {
+            const auto &entry = classes[i];
+
+            file << "    {\"name\": \"" << GetTypeNameSimple(*entry.type)
+                 << "\", \"count\": " << entry.count
+                 << ", \"instanceBytes\": " << entry.instanceBytes
+                 << ", \"resourceBytes\": " << entry.resourceBytes << "}"
+                 << (i + 1 < classes.size() ? ",\n" : "\n");
+        }
+
+        file << "  ]\n}\n";
+
+        return static_cast<bool>(file);
+    }
+};
+
+} // namespace HandcrankEngine
@@ -0,0 +1,208 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#define HANDCRANK_PROFILE_CONCAT_INNER(a, b) a##b
+#define HANDCRANK_PROFILE_CONCAT(a, b) HANDCRANK_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef HANDCRANK_ENGINE_PROFILE
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+namespace HandcrankEngine
+{
+
+inline const size_t PROFILER_CAPACITY = 1 << 16;
+
+inline const char *const PROFILE_OUTPUT_ENVIRONMENT_VARIABLE =
+    "HANDCRANK_ENGINE_PROFILE_OUTPUT";
+
+inline const char *const DEFAULT_PROFILE_OUTPUT_PATH =
+    "handcrank-profile.json";
+
+struct ProfileEvent
+{
+    const char *name;
+
+    Uint64 start;
+    Uint64 end;
+
+    uint32_t threadId;
+};
+
+/**
+ * Records timed zones into a fixed size ring buffer, overwriting the oldest
+ * zones once full, and writes them out as Chrome trace JSON that can be
+ * opened with chrome://tracing or https://ui.perfetto.dev.
+ */
+class Profiler
+{
+  private:
+    std::vector<ProfileEvent> events{PROFILER_CAPACITY};
+
+    std::atomic<uint64_t> eventCount{0};
+
+    std::atomic<uint32_t> threadCount{0};
+
+  public:
+    [[nodiscard]] static auto Get() -> Profiler &
+    {
+        static Profiler profiler;
+
+        return profiler;
+    }
+
+    [[nodiscard]] auto GetThreadId() -> uint32_t
+    {
+        thread_local uint32_t threadId = threadCount.fetch_add(1);
+
+        return threadId;
+    }
+
+    /**
+     * Record a zone.
+     *
+     * @param name Zone name. Must outlive the profiler, usually a string
+     * literal.
+     * @param start Performance counter value at the start of the zone.
+     * @param end Performance counter value at the end of the zone.
+     */
+    void Record(const char *name, Uint64 start, Uint64 end)
+    {
+        auto index = eventCount.fetch_add(1, std::memory_order_relaxed);
+
+        events[index % PROFILER_CAPACITY] = {name, start, end, GetThreadId()};
+    }
+
+    void Clear() { eventCount.store(0); }
+
+    /**
+     * Write recorded zones as Chrome trace JSON. Call while no zones are
+     * being recorded on other threads.
+     *
+     * @param path File to write to.
+     */
+    auto Dump(const std::string &path) const -> bool
+    {
+        std::ofstream file(path);
+
+        if (!file)
+        {
+            SDL_Log("Failed to write profile to %s", path.c_str());
+
+            return false;
+        }
+
+        auto count = eventCount.load();
+
+        auto first = count > PROFILER_CAPACITY ? count - PROFILER_CAPACITY : 0;
+
+        auto frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+        auto startCounter = events[first % PROFILER_CAPACITY].start;
+
+        for (auto i = first; i < count; i += 1)
+        {
+            startCounter =
+                std::min(startCounter, events[i % PROFILER_CAPACITY].start);
+        }
+
+        file << std::fixed << std::setprecision(3);
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        for (auto i = first; i < count; i += 1)
+        {
+            const auto &event = events[i % PROFILER_CAPACITY];
+
+            auto start = (event.start - startCounter) * 1000000.0 / frequency;
+            auto duration = (event.end - event.start) * 1000000.0 / frequency;
+
+            file << (i == first ? "" : ",") << "\n{\"name\":\"";
+
+            for (const auto *c = event.name; *c != '\0'; c += 1)
+            {
+                if (*c == '"' || *c == '\\')
+                {
+                    file << '\\';
+                }
+
+                file << *c;
+            }
+
+            file << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.threadId
+                 << ",\"ts\":" << start << ",\"dur\":" << duration << "}";
+        }
+
+        file << "\n]}\n";
+
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * Write recorded zones to the path in the HANDCRANK_ENGINE_PROFILE_OUTPUT
+     * environment variable, or handcrank-profile.json.
+     */
+    auto Dump() const -> bool
+    {
+        const auto *path = SDL_getenv(PROFILE_OUTPUT_ENVIRONMENT_VARIABLE);
+
+        return Dump(path != nullptr ? path : DEFAULT_PROFILE_OUTPUT_PATH);
+    }
+};
+
+/**
+ * Records the time between construction and destruction as a zone.
+ */
+class ProfileZone
+{
+  private:
+    const char *name;
+
+    Uint64 start;
+
+  public:
+    explicit ProfileZone(const char *name)
+        : name(name), start(SDL_GetPerformanceCounter())
+    {
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+    auto operator=(const ProfileZone &) -> ProfileZone & = delete;
+
+    ~ProfileZone()
+    {
+        Profiler::Get().Record(name, start, SDL_GetPerformanceCounter());
+    }
+};
+
+} // namespace HandcrankEngine
+
+#define HANDCRANK_PROFILE_ZONE(name)                                           \
+    HandcrankEngine::ProfileZone HANDCRANK_PROFILE_CONCAT(profileZone,         \
+                                                          __LINE__)(name)
+
+#define HANDCRANK_PROFILE_DUMP() HandcrankEngine::Profiler::Get().Dump()
+
+#else
+
+#define HANDCRANK_PROFILE_ZONE(name)
+
+#define HANDCRANK_PROFILE_DUMP()
+
+#endif
@@ -32,6 +32,11 @@ class RectRenderObject : public RenderObject
   public:
     using RenderObject::RenderObject;
 
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(RectRenderObject);
+    }
+
     /**
      * Set rect border color.
      *
@@ -100,7 +105,10 @@ class RectRenderObject : public RenderObject
             return;
         }
 
+        game->FlushRenderBatch();
+
         SDL_SetRenderDrawBlendMode(renderer, blendMode);
+        HANDCRANK_RENDER_STATE_CHANGE();
 
         auto transformedRect = GetTransformedRect();
 
@@ -108,16 +116,20 @@ class RectRenderObject : public RenderObject
         {
             SDL_SetRenderDrawColor(renderer, fillColor.r, fillColor.g,
                                    fillColor.b, fillColor.a);
+            HANDCRANK_RENDER_STATE_CHANGE();
 
             SDL_RenderFillRectF(renderer, &transformedRect);
+            HANDCRANK_RENDER_CALL(nullptr);
         }
 
         if (borderColorSet)
         {
             SDL_SetRenderDrawColor(renderer, borderColor.r, borderColor.g,
                                    borderColor.b, borderColor.a);
+            HANDCRANK_RENDER_STATE_CHANGE();
 
             SDL_RenderDrawRectF(renderer, &transformedRect);
+            HANDCRANK_RENDER_CALL(nullptr);
         }
 
         RenderObject::Render(renderer);
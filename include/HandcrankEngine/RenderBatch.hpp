@@ -0,0 +1,117 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <vector>
+
+#include <SDL.h>
+
+#include "RenderStats.hpp"
+
+#include "Utilities.hpp"
+
+namespace HandcrankEngine
+{
+
+/**
+ * Collects consecutive textured quads that share a texture and blend mode
+ * and submits them with a single SDL_RenderGeometry call. Tint and alpha are
+ * baked into the vertex colors instead of the texture color and alpha mods.
+ */
+class RenderBatch
+{
+  private:
+    SDL_Texture *texture = nullptr;
+
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+  public:
+    [[nodiscard]] auto IsEmpty() const -> bool { return indices.empty(); }
+
+    [[nodiscard]] auto GetQuadCount() const -> size_t
+    {
+        return vertices.size() / 4;
+    }
+
+    /**
+     * Add a textured quad to the batch, flushing first if the texture or its
+     * blend mode differs from the quads already in the batch.
+     *
+     * @param renderer A structure representing rendering state.
+     * @param texture The texture to sample from.
+     * @param destRect Destination rect in screen space.
+     * @param srcRect Source rect in texture space.
+     * @param color Tint and alpha applied to the quad.
+     * @param textureWidth Width of the texture in pixels.
+     * @param textureHeight Height of the texture in pixels.
+     * @param flip Flip applied to the texture coordinates.
+     */
+    void AddQuad(SDL_Renderer *renderer, SDL_Texture *texture,
+                 const SDL_FRect &destRect, const SDL_FRect &srcRect,
+                 const SDL_Color &color, float textureWidth,
+                 float textureHeight, SDL_RendererFlip flip = SDL_FLIP_NONE)
+    {
+        SDL_BlendMode textureBlendMode = SDL_BLENDMODE_BLEND;
+
+        SDL_GetTextureBlendMode(texture, &textureBlendMode);
+
+        if (texture != this->texture || textureBlendMode != blendMode)
+        {
+            Flush(renderer);
+
+            this->texture = texture;
+
+            blendMode = textureBlendMode;
+        }
+
+        auto index = vertices.size();
+
+        GenerateTextureQuad(vertices, indices, destRect, srcRect, color,
+                            textureWidth, textureHeight);
+
+        if (flip != SDL_FLIP_NONE)
+        {
+            FlipTextureQuad(vertices.data() + index, flip);
+        }
+    }
+
+    /**
+     * Submit all pending quads.
+     *
+     * @param renderer A structure representing rendering state.
+     */
+    void Flush(SDL_Renderer *renderer)
+    {
+        if (indices.empty())
+        {
+            return;
+        }
+
+        SDL_SetTextureColorMod(texture, SDL_ALPHA_OPAQUE, SDL_ALPHA_OPAQUE,
+                               SDL_ALPHA_OPAQUE);
+        HANDCRANK_RENDER_STATE_CHANGE();
+
+        SDL_SetTextureAlphaMod(texture, SDL_ALPHA_OPAQUE);
+        HANDCRANK_RENDER_STATE_CHANGE();
+
+        SDL_RenderGeometry(renderer, texture, vertices.data(),
+                           static_cast<int>(vertices.size()), indices.data(),
+                           static_cast<int>(indices.size()));
+        HANDCRANK_RENDER_CALL(texture);
+
+        vertices.clear();
+        indices.clear();
+    }
+};
+
+} // namespace HandcrankEngine
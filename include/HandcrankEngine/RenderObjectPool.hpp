@@ -0,0 +1,160 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace HandcrankEngine
+{
+
+class RenderObject;
+
+class RenderObjectPoolBase
+{
+  public:
+    virtual ~RenderObjectPoolBase() = default;
+
+    virtual void Release(RenderObject *object) = 0;
+};
+
+/**
+ * Pool of pre-allocated render objects for things that are spawned and
+ * destroyed often, such as bullets and particles. Objects are acquired from
+ * the pool and added to the game as usual. Destroying a pooled object returns
+ * it to the pool instead of releasing it, after its engine state is reset and
+ * RenderObject::OnReuse is called.
+ *
+ * The pool must outlive the game it spawns objects into, or objects still in
+ * the game when the pool is destroyed are released normally instead.
+ */
+template <typename T> class RenderObjectPool : public RenderObjectPoolBase
+{
+  private:
+    std::function<std::shared_ptr<T>()> factory;
+
+    std::vector<std::shared_ptr<T>> instances;
+
+    std::vector<std::shared_ptr<T>> available;
+
+    auto Create() -> std::shared_ptr<T>
+    {
+        auto instance = factory();
+
+        instance->SetPool(this);
+
+        instances.emplace_back(instance);
+
+        return instance;
+    }
+
+  public:
+    /**
+     * Create a pool of default constructed objects.
+     *
+     * @param capacity Number of objects to allocate up front.
+     */
+    explicit RenderObjectPool(size_t capacity)
+        : RenderObjectPool(capacity, [] { return std::make_shared<T>(); })
+    {
+    }
+
+    /**
+     * Create a pool of objects made by a factory.
+     *
+     * @param capacity Number of objects to allocate up front.
+     * @param factory Function that creates a new object.
+     */
+    RenderObjectPool(size_t capacity,
+                     std::function<std::shared_ptr<T>()> factory)
+        : factory(std::move(factory))
+    {
+        Reserve(capacity);
+    }
+
+    RenderObjectPool(const RenderObjectPool &) = delete;
+    auto operator=(const RenderObjectPool &) -> RenderObjectPool & = delete;
+
+    ~RenderObjectPool() override
+    {
+        for (const auto &instance : instances)
+        {
+            instance->SetPool(nullptr);
+        }
+    }
+
+    /**
+     * Allocate objects until the pool holds at least capacity objects.
+     *
+     * @param capacity Total number of objects.
+     */
+    void Reserve(size_t capacity)
+    {
+        instances.reserve(capacity);
+        available.reserve(capacity);
+
+        while (instances.size() < capacity)
+        {
+            available.emplace_back(Create());
+        }
+    }
+
+    /**
+     * Take an object from the pool. A new object is allocated when every
+     * object is in use.
+     */
+    [[nodiscard]] auto Acquire() -> std::shared_ptr<T>
+    {
+        if (available.empty())
+        {
+            return Create();
+        }
+
+        auto instance = std::move(available.back());
+
+        available.pop_back();
+
+        return instance;
+    }
+
+    /**
+     * Return a destroyed object to the pool. Called by the game when a pooled
+     * object marked for destroy is removed from its parent.
+     *
+     * @param object Object that was acquired from this pool.
+     */
+    void Release(RenderObject *object) override
+    {
+        auto *instance = static_cast<T *>(object);
+
+        instance->ResetForReuse();
+
+        available.emplace_back(
+            std::static_pointer_cast<T>(instance->shared_from_this()));
+    }
+
+    [[nodiscard]] auto GetCapacity() const -> size_t
+    {
+        return instances.size();
+    }
+
+    [[nodiscard]] auto GetAvailableCount() const -> size_t
+    {
+        return available.size();
+    }
+
+    [[nodiscard]] auto GetActiveCount() const -> size_t
+    {
+        return instances.size() - available.size();
+    }
+};
+
+} // namespace HandcrankEngine
@@ -0,0 +1,113 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace HandcrankEngine
+{
+
+class RenderObject;
+
+/**
+ * Non-owning view over a list of render objects that are all known to be of
+ * type T. Iterating yields T pointers without copying or casting at runtime.
+ * A view is invalidated when objects are added to or destroyed in the game.
+ */
+template <typename T> class RenderObjectView
+{
+  private:
+    const std::vector<RenderObject *> *objects = nullptr;
+
+  public:
+    class Iterator
+    {
+      private:
+        std::vector<RenderObject *>::const_iterator it;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T **;
+        using reference = T *;
+
+        explicit Iterator(std::vector<RenderObject *>::const_iterator it)
+            : it(it)
+        {
+        }
+
+        auto operator*() const -> T * { return static_cast<T *>(*it); }
+
+        auto operator++() -> Iterator &
+        {
+            ++it;
+
+            return *this;
+        }
+
+        auto operator++(int) -> Iterator
+        {
+            auto previous = *this;
+
+            ++it;
+
+            return previous;
+        }
+
+        auto operator==(const Iterator &other) const -> bool
+        {
+            return it == other.it;
+        }
+
+        auto operator!=(const Iterator &other) const -> bool
+        {
+            return it != other.it;
+        }
+    };
+
+    RenderObjectView() = default;
+
+    explicit RenderObjectView(const std::vector<RenderObject *> &objects)
+        : objects(&objects)
+    {
+    }
+
+    [[nodiscard]] auto begin() const -> Iterator
+    {
+        return objects != nullptr ? Iterator(objects->begin()) : Iterator({});
+    }
+
+    [[nodiscard]] auto end() const -> Iterator
+    {
+        return objects != nullptr ? Iterator(objects->end()) : Iterator({});
+    }
+
+    [[nodiscard]] auto size() const -> size_t
+    {
+        return objects != nullptr ? objects->size() : 0;
+    }
+
+    [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+    [[nodiscard]] auto operator[](size_t index) const -> T *
+    {
+        return static_cast<T *>((*objects)[index]);
+    }
+
+    [[nodiscard]] auto front() const -> T *
+    {
+        return empty() ? nullptr : (*this)[0];
+    }
+};
+
+} // namespace HandcrankEngine
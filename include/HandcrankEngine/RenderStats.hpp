@@ -0,0 +1,102 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#ifdef HANDCRANK_ENGINE_DEBUG
+
+#include <cstdint>
+
+#include <SDL.h>
+
+namespace HandcrankEngine
+{
+
+/**
+ * Counts of the work submitted to the renderer in a frame.
+ */
+struct RenderStats
+{
+    // SDL_RenderClear, SDL_RenderCopy*, SDL_Render*Rect* and
+    // SDL_RenderGeometry calls.
+    uint32_t renderCalls = 0;
+
+    // Render calls that used a different texture from the textured render
+    // call before them.
+    uint32_t textureBinds = 0;
+
+    // Texture color mod, alpha mod and blend mode, and renderer draw color,
+    // blend mode and target changes.
+    uint32_t stateChanges = 0;
+
+    uint32_t objectsVisited = 0;
+
+    uint32_t objectsCulled = 0;
+};
+
+inline RenderStats renderStats;
+
+inline RenderStats previousRenderStats;
+
+inline SDL_Texture *renderStatsBoundTexture = nullptr;
+
+inline void RecordRenderCall(SDL_Texture *texture)
+{
+    renderStats.renderCalls += 1;
+
+    if (texture != nullptr && texture != renderStatsBoundTexture)
+    {
+        renderStats.textureBinds += 1;
+
+        renderStatsBoundTexture = texture;
+    }
+}
+
+/**
+ * Keep the counts of the frame that just finished and start counting the
+ * next one.
+ */
+inline void EndRenderStatsFrame()
+{
+    previousRenderStats = renderStats;
+
+    renderStats = RenderStats();
+
+    renderStatsBoundTexture = nullptr;
+}
+
+} // namespace HandcrankEngine
+
+#define HANDCRANK_RENDER_CALL(texture)                                         \
+    HandcrankEngine::RecordRenderCall(texture)
+
+#define HANDCRANK_RENDER_STATE_CHANGE()                                        \
+    HandcrankEngine::renderStats.stateChanges += 1
+
+#define HANDCRANK_RENDER_OBJECT_VISITED()                                      \
+    HandcrankEngine::renderStats.objectsVisited += 1
+
+#define HANDCRANK_RENDER_OBJECT_CULLED()                                       \
+    HandcrankEngine::renderStats.objectsCulled += 1
+
+#define HANDCRANK_RENDER_END_FRAME() HandcrankEngine::EndRenderStatsFrame()
+
+#else
+
+#define HANDCRANK_RENDER_CALL(texture)
+
+#define HANDCRANK_RENDER_STATE_CHANGE()
+
+#define HANDCRANK_RENDER_OBJECT_VISITED()
+
+#define HANDCRANK_RENDER_OBJECT_CULLED()
+
+#define HANDCRANK_RENDER_END_FRAME()
+
+#endif
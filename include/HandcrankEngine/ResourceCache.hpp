@@ -0,0 +1,221 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <SDL.h>
+
+#include "JobSystem.hpp"
+
+namespace HandcrankEngine
+{
+
+/**
+ * Cache of shared resources that tracks an estimated size for each entry.
+ * When a budget is set, least recently used entries that are only referenced
+ * by the cache are evicted until the cache fits. A budget of 0 never evicts.
+ * Caches are not thread safe and must only be used outside of jobs.
+ */
+template <typename T> class ResourceCache
+{
+  private:
+    struct Entry
+    {
+        std::shared_ptr<T> resource;
+
+        size_t bytes;
+
+        uint64_t lastUsed;
+    };
+
+    std::unordered_map<size_t, Entry> entries;
+
+    // Resources handed out as raw pointers, which can't be tracked by
+    // reference count and so are never evicted.
+    std::unordered_set<const T *> pinned;
+
+    size_t totalBytes = 0;
+
+    size_t budget = 0;
+
+    uint64_t useCounter = 0;
+
+  public:
+    [[nodiscard]] auto GetBudget() const -> size_t { return budget; }
+
+    /**
+     * Set the budget in bytes and evict entries until the cache fits.
+     *
+     * @param budget Maximum estimated size in bytes, 0 for unlimited.
+     */
+    void SetBudget(size_t budget)
+    {
+        this->budget = budget;
+
+        Evict();
+    }
+
+    [[nodiscard]] auto GetTotalBytes() const -> size_t { return totalBytes; }
+
+    [[nodiscard]] auto GetCount() const -> size_t { return entries.size(); }
+
+    /**
+     * Find a resource and mark it as recently used.
+     *
+     * @param key Cache key.
+     */
+    [[nodiscard]] auto Find(size_t key) -> std::shared_ptr<T>
+    {
+        SDL_assert(!JobSystem::IsRunningJob());
+
+        auto match = entries.find(key);
+
+        if (match == entries.end())
+        {
+            return nullptr;
+        }
+
+        match->second.lastUsed = ++useCounter;
+
+        return match->second.resource;
+    }
+
+    /**
+     * Add or replace a resource, then evict entries if over budget. The new
+     * resource is never evicted by its own insert.
+     *
+     * @param key Cache key.
+     * @param resource Resource to cache.
+     * @param bytes Estimated size of the resource in bytes.
+     */
+    void Insert(size_t key, const std::shared_ptr<T> &resource, size_t bytes)
+    {
+        SDL_assert(!JobSystem::IsRunningJob());
+
+        Erase(key);
+
+        entries.insert_or_assign(key, Entry{resource, bytes, ++useCounter});
+
+        totalBytes += bytes;
+
+        Evict(key);
+    }
+
+    /**
+     * Keep a cached resource from ever being evicted, for resources handed
+     * out as raw pointers. It is still released by Erase and Clear.
+     *
+     * @param resource Cached resource.
+     */
+    void Pin(const std::shared_ptr<T> &resource)
+    {
+        if (resource != nullptr)
+        {
+            pinned.insert(resource.get());
+        }
+    }
+
+    [[nodiscard]] auto IsPinned(const std::shared_ptr<T> &resource) const
+        -> bool
+    {
+        return pinned.count(resource.get()) > 0;
+    }
+
+    void Erase(size_t key)
+    {
+        auto match = entries.find(key);
+
+        if (match == entries.end())
+        {
+            return;
+        }
+
+        pinned.erase(match->second.resource.get());
+
+        totalBytes -= match->second.bytes;
+
+        entries.erase(match);
+    }
+
+    void Clear()
+    {
+        entries.clear();
+
+        pinned.clear();
+
+        totalBytes = 0;
+    }
+
+    /**
+     * Evict every entry that is only referenced by the cache and not pinned.
+     */
+    void EvictUnused()
+    {
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            if (it->second.resource.use_count() == 1 &&
+                !IsPinned(it->second.resource))
+            {
+                totalBytes -= it->second.bytes;
+
+                it = entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    /**
+     * Evict least recently used entries that are only referenced by the
+     * cache and not pinned until the cache fits within its budget.
+     *
+     * @param keep Key of an entry that must not be evicted.
+     */
+    void Evict(size_t keep = SIZE_MAX)
+    {
+        if (budget == 0 || totalBytes <= budget)
+        {
+            return;
+        }
+
+        std::vector<std::pair<uint64_t, size_t>> candidates;
+
+        for (const auto &[key, entry] : entries)
+        {
+            if (key != keep && entry.resource.use_count() == 1 &&
+                !IsPinned(entry.resource))
+            {
+                candidates.emplace_back(entry.lastUsed, key);
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end());
+
+        for (const auto &[lastUsed, key] : candidates)
+        {
+            if (totalBytes <= budget)
+            {
+                break;
+            }
+
+            Erase(key);
+        }
+    }
+};
+
+} // namespace HandcrankEngine
@@ -24,6 +24,11 @@ class Scene : public RenderObject
   public:
     using RenderObject::RenderObject;
 
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(Scene);
+    }
+
     void SetCurrentSceneCallback(
         const std::function<void(std::type_index)> &callback)
     {
@@ -28,6 +28,11 @@ class SceneManager : public RenderObject
   public:
     using RenderObject::RenderObject;
 
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(SceneManager);
+    }
+
     void Start() override {}
 
     auto SetCurrentScene(const std::shared_ptr<Scene> &scene) -> bool
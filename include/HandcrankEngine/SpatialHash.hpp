@@ -0,0 +1,283 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL.h>
+
+namespace HandcrankEngine
+{
+
+inline const float DEFAULT_SPATIAL_HASH_CELL_SIZE = 128;
+
+/**
+ * Uniform grid broadphase. Rects are bucketed into every cell they overlap
+ * and only rects that share a cell are reported as candidate pairs.
+ */
+class SpatialHash
+{
+  public:
+    struct Proxy
+    {
+        SDL_FRect rect;
+
+        int minCellX;
+        int minCellY;
+        int maxCellX;
+        int maxCellY;
+
+        bool isActive;
+    };
+
+  private:
+    float cellSize = DEFAULT_SPATIAL_HASH_CELL_SIZE;
+
+    std::vector<Proxy> proxies;
+    std::vector<size_t> freeProxies;
+
+    std::unordered_map<int64_t, std::vector<size_t>> cells;
+
+  public:
+    SpatialHash() = default;
+    explicit SpatialHash(float cellSize) : cellSize(cellSize) {}
+
+    [[nodiscard]] auto GetCellSize() const -> float { return cellSize; }
+
+    /**
+     * Set the cell size and rebucket every active proxy.
+     *
+     * @param cellSize Width and height of a single grid cell.
+     */
+    void SetCellSize(float cellSize)
+    {
+        if (cellSize <= 0 || cellSize == this->cellSize)
+        {
+            return;
+        }
+
+        this->cellSize = cellSize;
+
+        cells.clear();
+
+        for (size_t id = 0; id < proxies.size(); id += 1)
+        {
+            auto &proxy = proxies[id];
+
+            if (proxy.isActive)
+            {
+                CalculateCellRange(proxy);
+
+                AddToCells(id, proxy);
+            }
+        }
+    }
+
+    [[nodiscard]] auto GetProxyCount() const -> size_t
+    {
+        return proxies.size() - freeProxies.size();
+    }
+
+    [[nodiscard]] auto GetProxy(size_t id) const -> const Proxy &
+    {
+        return proxies[id];
+    }
+
+    auto Insert(const SDL_FRect &rect) -> size_t
+    {
+        size_t id = 0;
+
+        if (!freeProxies.empty())
+        {
+            id = freeProxies.back();
+
+            freeProxies.pop_back();
+        }
+        else
+        {
+            id = proxies.size();
+
+            proxies.emplace_back();
+        }
+
+        auto &proxy = proxies[id];
+
+        proxy.rect = rect;
+        proxy.isActive = true;
+
+        CalculateCellRange(proxy);
+
+        AddToCells(id, proxy);
+
+        return id;
+    }
+
+    /**
+     * Move a proxy. Cells are only touched when the proxy crosses a cell
+     * boundary.
+     */
+    void Update(size_t id, const SDL_FRect &rect)
+    {
+        auto &proxy = proxies[id];
+
+        auto previous = proxy;
+
+        proxy.rect = rect;
+
+        CalculateCellRange(proxy);
+
+        if (proxy.minCellX == previous.minCellX &&
+            proxy.minCellY == previous.minCellY &&
+            proxy.maxCellX == previous.maxCellX &&
+            proxy.maxCellY == previous.maxCellY)
+        {
+            return;
+        }
+
+        RemoveFromCells(id, previous);
+
+        AddToCells(id, proxy);
+    }
+
+    void Remove(size_t id)
+    {
+        auto &proxy = proxies[id];
+
+        if (!proxy.isActive)
+        {
+            return;
+        }
+
+        RemoveFromCells(id, proxy);
+
+        proxy.isActive = false;
+
+        freeProxies.emplace_back(id);
+    }
+
+    void Clear()
+    {
+        proxies.clear();
+        freeProxies.clear();
+        cells.clear();
+    }
+
+    /**
+     * Call callback once for every pair of proxies that share at least one
+     * cell. Pairs are only reported from the first cell they share, so each
+     * pair is visited exactly once.
+     *
+     * @param callback Function called with the ids of both proxies.
+     */
+    template <typename F> void ForEachCandidatePair(F callback) const
+    {
+        for (size_t idA = 0; idA < proxies.size(); idA += 1)
+        {
+            const auto &proxyA = proxies[idA];
+
+            if (!proxyA.isActive)
+            {
+                continue;
+            }
+
+            for (auto y = proxyA.minCellY; y <= proxyA.maxCellY; y += 1)
+            {
+                for (auto x = proxyA.minCellX; x <= proxyA.maxCellX; x += 1)
+                {
+                    auto match = cells.find(GetCellKey(x, y));
+
+                    if (match == cells.end())
+                    {
+                        continue;
+                    }
+
+                    for (const auto idB : match->second)
+                    {
+                        if (idB <= idA)
+                        {
+                            continue;
+                        }
+
+                        const auto &proxyB = proxies[idB];
+
+                        if (std::max(proxyA.minCellX, proxyB.minCellX) != x ||
+                            std::max(proxyA.minCellY, proxyB.minCellY) != y)
+                        {
+                            continue;
+                        }
+
+                        callback(idA, idB);
+                    }
+                }
+            }
+        }
+    }
+
+  private:
+    [[nodiscard]] static auto GetCellKey(int x, int y) -> int64_t
+    {
+        return (static_cast<int64_t>(x) << 32) ^
+               static_cast<int64_t>(static_cast<uint32_t>(y));
+    }
+
+    void CalculateCellRange(Proxy &proxy) const
+    {
+        proxy.minCellX = static_cast<int>(std::floor(proxy.rect.x / cellSize));
+        proxy.minCellY = static_cast<int>(std::floor(proxy.rect.y / cellSize));
+        proxy.maxCellX = static_cast<int>(
+            std::floor((proxy.rect.x + proxy.rect.w) / cellSize));
+        proxy.maxCellY = static_cast<int>(
+            std::floor((proxy.rect.y + proxy.rect.h) / cellSize));
+    }
+
+    void AddToCells(size_t id, const Proxy &proxy)
+    {
+        for (auto y = proxy.minCellY; y <= proxy.maxCellY; y += 1)
+        {
+            for (auto x = proxy.minCellX; x <= proxy.maxCellX; x += 1)
+            {
+                cells[GetCellKey(x, y)].emplace_back(id);
+            }
+        }
+    }
+
+    void RemoveFromCells(size_t id, const Proxy &proxy)
+    {
+        for (auto y = proxy.minCellY; y <= proxy.maxCellY; y += 1)
+        {
+            for (auto x = proxy.minCellX; x <= proxy.maxCellX; x += 1)
+            {
+                auto match = cells.find(GetCellKey(x, y));
+
+                if (match == cells.end())
+                {
+                    continue;
+                }
+
+                auto &cell = match->second;
+
+                auto it = std::find(cell.begin(), cell.end(), id);
+
+                if (it != cell.end())
+                {
+                    *it = cell.back();
+
+                    cell.pop_back();
+                }
+            }
+        }
+    }
+};
+
+} // namespace HandcrankEngine
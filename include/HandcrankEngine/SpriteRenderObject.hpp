@@ -37,6 +37,11 @@ class SpriteRenderObject : public ImageRenderObject
   public:
     using ImageRenderObject::ImageRenderObject;
 
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(SpriteRenderObject);
+    }
+
     void Play() { isPlaying = true; }
     void PlayOnce()
     {
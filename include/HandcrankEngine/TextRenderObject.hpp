@@ -9,7 +9,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <SDL.h>
 #include <SDL_ttf.h>
@@ -23,16 +26,30 @@ namespace HandcrankEngine
 class TextRenderObject : public RenderObject
 {
   protected:
+    struct GlyphPosition
+    {
+        Uint32 codepoint;
+
+        float x;
+        float y;
+    };
+
     TTF_Font *font = nullptr;
 
+    std::shared_ptr<TTF_Font> sharedFont;
+
     SDL_Color color{MAX_R, MAX_G, MAX_B, MAX_ALPHA};
 
-    const char *text = nullptr;
+    std::string text;
 
     SDL_Surface *textSurface = nullptr;
 
     SDL_Texture *textTexture = nullptr;
 
+    bool isGlyphAtlasEnabled = false;
+
+    std::vector<GlyphPosition> glyphLayout;
+
   public:
     using RenderObject::RenderObject;
 
@@ -49,12 +66,56 @@ class TextRenderObject : public RenderObject
         }
     };
 
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(TextRenderObject);
+    }
+
+    /**
+     * Include the rendered text surface and texture, and the glyph layout.
+     */
+    [[nodiscard]] auto GetResourceBytes() const -> size_t override
+    {
+        auto bytes = RenderObject::GetResourceBytes() +
+                     glyphLayout.capacity() * sizeof(GlyphPosition);
+
+        if (textSurface != nullptr)
+        {
+            bytes += static_cast<size_t>(textSurface->pitch) * textSurface->h;
+        }
+
+        if (textTexture != nullptr)
+        {
+            bytes += GetTextureByteSize(textTexture);
+        }
+
+        return bytes;
+    }
+
     /**
      * Set text font.
      *
      * @param font Font value to set.
      */
-    void SetFont(TTF_Font *font) { this->font = font; }
+    void SetFont(TTF_Font *font)
+    {
+        this->font = font;
+
+        sharedFont = nullptr;
+    }
+
+    /**
+     * Set text font from a shared font, keeping it alive for as long as this
+     * object uses it.
+     *
+     * @param font Font value to set.
+     */
+    void SetSharedFont(const std::shared_ptr<TTF_Font> &font)
+    {
+        this->font = font.get();
+
+        sharedFont = font;
+    }
 
     /**
      * Load font from a path.
@@ -67,7 +128,16 @@ class TextRenderObject : public RenderObject
      */
     void LoadFont(const char *path, int ptSize = DEFAULT_FONT_SIZE)
     {
-        font = LoadCachedFont(path, ptSize);
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this,
+                         path = std::string(path), ptSize]
+                        { LoadFont(path.c_str(), ptSize); });
+
+            return;
+        }
+
+        SetSharedFont(LoadCachedSharedFont(path, ptSize));
     }
 
     /**
@@ -79,7 +149,30 @@ class TextRenderObject : public RenderObject
      */
     void LoadFontRW(const void *mem, int size, int ptSize = DEFAULT_FONT_SIZE)
     {
-        font = LoadCachedFont(mem, size, ptSize);
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this, mem, size, ptSize]
+                        { LoadFontRW(mem, size, ptSize); });
+
+            return;
+        }
+
+        SetSharedFont(LoadCachedSharedFont(mem, size, ptSize));
+    }
+
+    /**
+     * Render text from glyphs cached in a shared atlas instead of rasterizing
+     * the whole string into its own texture. Changing text only rebuilds the
+     * glyph layout, and text sharing a font is batched into one draw call.
+     * Call before setting text.
+     */
+    void EnableGlyphAtlas() { isGlyphAtlasEnabled = true; }
+
+    void DisableGlyphAtlas() { isGlyphAtlasEnabled = false; }
+
+    [[nodiscard]] auto IsGlyphAtlasEnabled() const -> bool
+    {
+        return isGlyphAtlasEnabled;
     }
 
     /**
@@ -103,6 +196,16 @@ class TextRenderObject : public RenderObject
 
         this->text = text;
 
+        // TTF and texture calls aren't thread safe, so rasterize once the
+        // parallel update has finished.
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this, text = this->text]
+                        { SetText(text.c_str()); });
+
+            return;
+        }
+
         if (textTexture != nullptr)
         {
             SDL_DestroyTexture(textTexture);
@@ -115,7 +218,14 @@ class TextRenderObject : public RenderObject
             textSurface = nullptr;
         }
 
-        textSurface = TTF_RenderText_Blended(font, this->text, color);
+        if (isGlyphAtlasEnabled)
+        {
+            LayoutGlyphs(0);
+
+            return;
+        }
+
+        textSurface = TTF_RenderText_Blended(font, this->text.c_str(), color);
 
         if (textSurface == nullptr)
         {
@@ -148,6 +258,14 @@ class TextRenderObject : public RenderObject
 
         this->text = text;
 
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this, text = this->text]
+                        { SetWrappedText(text.c_str()); });
+
+            return;
+        }
+
         if (textTexture != nullptr)
         {
             SDL_DestroyTexture(textTexture);
@@ -160,8 +278,15 @@ class TextRenderObject : public RenderObject
             textSurface = nullptr;
         }
 
-        textSurface = TTF_RenderText_Blended_Wrapped(font, this->text, color,
-                                                     GetRect().w);
+        if (isGlyphAtlasEnabled)
+        {
+            LayoutGlyphs(static_cast<int>(GetRect().w));
+
+            return;
+        }
+
+        textSurface = TTF_RenderText_Blended_Wrapped(
+            font, this->text.c_str(), color, GetRect().w);
 
         if (textSurface == nullptr)
         {
@@ -185,7 +310,100 @@ class TextRenderObject : public RenderObject
 
     auto GetText() -> std::string
     {
-        return text != nullptr ? std::string(text) : std::string();
+        return text;
+    }
+
+    /**
+     * Position each character of the text for glyph atlas rendering and
+     * resize to fit. Characters are Latin-1, matching TTF_RenderText.
+     *
+     * @param wrapWidth Width to word wrap at, 0 for a single line.
+     */
+    void LayoutGlyphs(int wrapWidth)
+    {
+        glyphLayout.clear();
+
+        const auto lineSkip = static_cast<float>(TTF_FontLineSkip(font));
+
+        auto x = 0.0F;
+        auto y = 0.0F;
+        auto width = 0.0F;
+
+        Uint32 previous = 0;
+
+        // SIZE_MAX marks that the current line has no space to wrap at.
+        size_t lastSpace = SIZE_MAX;
+
+        for (const auto *c = text.c_str(); *c != '\0'; c += 1)
+        {
+            Uint32 codepoint = static_cast<unsigned char>(*c);
+
+            if (codepoint == '\n' && wrapWidth > 0)
+            {
+                width = std::max(width, x);
+
+                x = 0;
+                y += lineSkip;
+
+                previous = 0;
+
+                lastSpace = SIZE_MAX;
+
+                continue;
+            }
+
+            if (previous != 0)
+            {
+                x += static_cast<float>(
+                    TTF_GetFontKerningSizeGlyphs32(font, previous, codepoint));
+            }
+
+            auto advance = 0;
+
+            TTF_GlyphMetrics32(font, codepoint, nullptr, nullptr, nullptr,
+                               nullptr, &advance);
+
+            if (wrapWidth > 0 && x + advance > wrapWidth &&
+                lastSpace != SIZE_MAX)
+            {
+                auto lineWidth = glyphLayout[lastSpace].x;
+
+                auto shift = lastSpace + 1 < glyphLayout.size()
+                                 ? glyphLayout[lastSpace + 1].x
+                                 : x;
+
+                for (auto i = lastSpace + 1; i < glyphLayout.size(); i += 1)
+                {
+                    glyphLayout[i].x -= shift;
+                    glyphLayout[i].y += lineSkip;
+                }
+
+                glyphLayout.erase(glyphLayout.begin() +
+                                  static_cast<std::ptrdiff_t>(lastSpace));
+
+                width = std::max(width, lineWidth);
+
+                x -= shift;
+                y += lineSkip;
+
+                lastSpace = SIZE_MAX;
+            }
+
+            if (codepoint == ' ')
+            {
+                lastSpace = glyphLayout.size();
+            }
+
+            glyphLayout.push_back({codepoint, x, y});
+
+            x += static_cast<float>(advance);
+
+            previous = codepoint;
+        }
+
+        width = std::max(width, x);
+
+        SetDimension(width, y + static_cast<float>(TTF_FontHeight(font)));
     }
 
     /**
@@ -200,6 +418,15 @@ class TextRenderObject : public RenderObject
             return;
         }
 
+        if (isGlyphAtlasEnabled)
+        {
+            RenderGlyphs(renderer);
+
+            RenderObject::Render(renderer);
+
+            return;
+        }
+
         if (textTexture == nullptr && textSurface != nullptr)
         {
             textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
@@ -207,10 +434,85 @@ class TextRenderObject : public RenderObject
 
         auto transformedRect = GetTransformedRect();
 
+        game->FlushRenderBatch();
+
         SDL_RenderCopyF(renderer, textTexture, nullptr, &transformedRect);
+        HANDCRANK_RENDER_CALL(textTexture);
 
         RenderObject::Render(renderer);
     }
+
+    /**
+     * Render the glyph layout as quads into the render batch.
+     *
+     * @param renderer A structure representing rendering state.
+     */
+    void RenderGlyphs(SDL_Renderer *renderer)
+    {
+        const auto &rect = GetRect();
+
+        auto transformedRect = GetTransformedRect();
+
+        auto scaleX = rect.w > 0 ? transformedRect.w / rect.w : 1;
+        auto scaleY = rect.h > 0 ? transformedRect.h / rect.h : 1;
+
+        auto &glyphAtlas = GetGlyphAtlas(renderer);
+
+        // Rasterizing a new glyph can repack an atlas page, which destroys
+        // the old page texture and switches the render target. Flush quads
+        // that still reference it and rasterize every glyph before queuing
+        // any.
+        auto hasFlushed = false;
+
+        for (const auto &position : glyphLayout)
+        {
+            if (glyphAtlas.HasGlyph(font, position.codepoint))
+            {
+                continue;
+            }
+
+            if (!hasFlushed)
+            {
+                game->FlushRenderBatch();
+
+                hasFlushed = true;
+            }
+
+            glyphAtlas.GetGlyph(font, position.codepoint);
+        }
+
+        auto &renderBatch = game->GetRenderBatch();
+
+        for (const auto &position : glyphLayout)
+        {
+            const auto *glyph = glyphAtlas.GetGlyph(font, position.codepoint);
+
+            if (glyph == nullptr)
+            {
+                continue;
+            }
+
+            const auto &region = *glyph->region;
+
+            renderBatch.AddQuad(
+                renderer, region.texture.get(),
+                {transformedRect.x + (position.x + glyph->offsetX) * scaleX,
+                 transformedRect.y + position.y * scaleY,
+                 static_cast<float>(region.rect.w) * scaleX,
+                 static_cast<float>(region.rect.h) * scaleY},
+                {static_cast<float>(region.rect.x),
+                 static_cast<float>(region.rect.y),
+                 static_cast<float>(region.rect.w),
+                 static_cast<float>(region.rect.h)},
+                color, static_cast<float>(region.textureWidth),
+                static_cast<float>(region.textureHeight));
+        }
+
+        if (!game->IsRenderBatchingEnabled())
+        {
+            game->FlushRenderBatch();
+        }
+    }
 };
 
 } // namespace HandcrankEngine
@@ -0,0 +1,553 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <vector>
+
+#include <SDL.h>
+
+#include "RenderStats.hpp"
+
+namespace HandcrankEngine
+{
+
+inline const int DEFAULT_TEXTURE_ATLAS_PAGE_SIZE = 2048;
+
+inline const int TEXTURE_ATLAS_PADDING = 1;
+
+inline const float DEFAULT_TEXTURE_ATLAS_FRAGMENTATION_THRESHOLD = 0.5F;
+
+/**
+ * Part of a texture. Regions are shared between every object drawing them
+ * and are updated in place when their atlas page is repacked, so always read
+ * the texture and rect at draw time.
+ */
+struct TextureAtlasRegion
+{
+    std::shared_ptr<SDL_Texture> texture;
+
+    SDL_Rect rect{};
+
+    int textureWidth = 0;
+    int textureHeight = 0;
+};
+
+/**
+ * Skyline bottom-left rectangle packer.
+ */
+class SkylinePacker
+{
+  private:
+    struct Node
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    int width = 0;
+    int height = 0;
+
+    int usedArea = 0;
+
+    std::vector<Node> nodes;
+
+  public:
+    SkylinePacker() = default;
+    SkylinePacker(int width, int height) { Reset(width, height); }
+
+    void Reset(int width, int height)
+    {
+        this->width = width;
+        this->height = height;
+
+        usedArea = 0;
+
+        nodes.clear();
+        nodes.push_back({0, 0, width});
+    }
+
+    [[nodiscard]] auto GetUsedArea() const -> int { return usedArea; }
+
+    /**
+     * Find space for a rect, placing it as low as possible.
+     *
+     * @param w Width of the rect.
+     * @param h Height of the rect.
+     * @param result Position and size of the packed rect.
+     */
+    auto Insert(int w, int h, SDL_Rect &result) -> bool
+    {
+        auto bestIndex = -1;
+        auto bestBottom = INT_MAX;
+        auto bestWidth = INT_MAX;
+        auto bestY = 0;
+
+        for (auto i = 0; i < static_cast<int>(nodes.size()); i += 1)
+        {
+            auto y = Fit(i, w, h);
+
+            if (y < 0)
+            {
+                continue;
+            }
+
+            if (y + h < bestBottom ||
+                (y + h == bestBottom && nodes[i].width < bestWidth))
+            {
+                bestIndex = i;
+                bestBottom = y + h;
+                bestWidth = nodes[i].width;
+                bestY = y;
+            }
+        }
+
+        if (bestIndex < 0)
+        {
+            return false;
+        }
+
+        result = {nodes[bestIndex].x, bestY, w, h};
+
+        nodes.insert(nodes.begin() + bestIndex, {result.x, bestY + h, w});
+
+        for (auto i = bestIndex + 1; i < static_cast<int>(nodes.size());)
+        {
+            auto &previous = nodes[i - 1];
+            auto &node = nodes[i];
+
+            auto overlap = previous.x + previous.width - node.x;
+
+            if (overlap <= 0)
+            {
+                break;
+            }
+
+            node.x += overlap;
+            node.width -= overlap;
+
+            if (node.width > 0)
+            {
+                break;
+            }
+
+            nodes.erase(nodes.begin() + i);
+        }
+
+        for (auto i = 0; i + 1 < static_cast<int>(nodes.size());)
+        {
+            if (nodes[i].y == nodes[i + 1].y)
+            {
+                nodes[i].width += nodes[i + 1].width;
+
+                nodes.erase(nodes.begin() + i + 1);
+            }
+            else
+            {
+                i += 1;
+            }
+        }
+
+        usedArea += w * h;
+
+        return true;
+    }
+
+  private:
+    [[nodiscard]] auto Fit(int index, int w, int h) const -> int
+    {
+        auto x = nodes[index].x;
+
+        if (x + w > width)
+        {
+            return -1;
+        }
+
+        auto y = 0;
+        auto remaining = w;
+
+        for (auto i = index; remaining > 0; i += 1)
+        {
+            if (i >= static_cast<int>(nodes.size()))
+            {
+                return -1;
+            }
+
+            y = std::max(y, nodes[i].y);
+
+            if (y + h > height)
+            {
+                return -1;
+            }
+
+            remaining -= nodes[i].width;
+        }
+
+        return y;
+    }
+};
+
+/**
+ * Packs surfaces into a small number of large textures so that draws using
+ * different images can share a texture and be batched together. Once an
+ * insert does not fit, pages where more than fragmentationThreshold of the
+ * packed area belongs to regions nobody references anymore are repacked
+ * before a new page is created.
+ */
+class TextureAtlas
+{
+  private:
+    struct Page
+    {
+        std::shared_ptr<SDL_Texture> texture;
+
+        SkylinePacker packer;
+
+        std::vector<std::weak_ptr<TextureAtlasRegion>> regions;
+    };
+
+    SDL_Renderer *renderer = nullptr;
+
+    int pageSize = DEFAULT_TEXTURE_ATLAS_PAGE_SIZE;
+
+    float fragmentationThreshold =
+        DEFAULT_TEXTURE_ATLAS_FRAGMENTATION_THRESHOLD;
+
+    bool canRepack = false;
+
+    std::vector<Page> pages;
+
+  public:
+    explicit TextureAtlas(SDL_Renderer *renderer,
+                          int pageSize = DEFAULT_TEXTURE_ATLAS_PAGE_SIZE)
+        : renderer(renderer), pageSize(pageSize),
+          canRepack(SDL_RenderTargetSupported(renderer) == SDL_TRUE)
+    {
+    }
+
+    [[nodiscard]] auto GetRenderer() const -> SDL_Renderer *
+    {
+        return renderer;
+    }
+
+    [[nodiscard]] auto GetPageSize() const -> int { return pageSize; }
+
+    [[nodiscard]] auto GetPageCount() const -> size_t { return pages.size(); }
+
+    /**
+     * Estimated size in bytes of every page texture.
+     */
+    [[nodiscard]] auto GetByteSize() const -> size_t
+    {
+        return pages.size() * static_cast<size_t>(pageSize) * pageSize *
+               SDL_BYTESPERPIXEL(SDL_PIXELFORMAT_RGBA32);
+    }
+
+    void SetFragmentationThreshold(float fragmentationThreshold)
+    {
+        this->fragmentationThreshold = fragmentationThreshold;
+    }
+
+    /**
+     * Fraction of the packed area on a page that is no longer referenced.
+     *
+     * @param index Page index.
+     */
+    [[nodiscard]] auto GetFragmentation(size_t index) const -> float
+    {
+        const auto &page = pages[index];
+
+        auto usedArea = page.packer.GetUsedArea();
+
+        if (usedArea == 0)
+        {
+            return 0;
+        }
+
+        auto liveArea = 0;
+
+        for (const auto &weakRegion : page.regions)
+        {
+            if (auto region = weakRegion.lock())
+            {
+                liveArea += (region->rect.w + TEXTURE_ATLAS_PADDING) *
+                            (region->rect.h + TEXTURE_ATLAS_PADDING);
+            }
+        }
+
+        return 1 - static_cast<float>(liveArea) / usedArea;
+    }
+
+    /**
+     * Copy a surface into the atlas. Surfaces larger than a page get a
+     * texture of their own.
+     *
+     * @param surface Surface to copy.
+     */
+    auto Add(SDL_Surface *surface) -> std::shared_ptr<TextureAtlasRegion>
+    {
+        if (surface == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto *converted =
+            SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+
+        if (converted == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto region = std::make_shared<TextureAtlasRegion>();
+
+        auto paddedWidth = converted->w + TEXTURE_ATLAS_PADDING;
+        auto paddedHeight = converted->h + TEXTURE_ATLAS_PADDING;
+
+        if (paddedWidth > pageSize || paddedHeight > pageSize)
+        {
+            region->texture = std::shared_ptr<SDL_Texture>(
+                SDL_CreateTextureFromSurface(renderer, converted),
+                SDL_DestroyTexture);
+
+            region->rect = {0, 0, converted->w, converted->h};
+            region->textureWidth = converted->w;
+            region->textureHeight = converted->h;
+
+            SDL_FreeSurface(converted);
+
+            return region->texture != nullptr ? region : nullptr;
+        }
+
+        auto *page = FindPage(paddedWidth, paddedHeight, region->rect);
+
+        if (page == nullptr)
+        {
+            SDL_FreeSurface(converted);
+
+            return nullptr;
+        }
+
+        region->rect.w -= TEXTURE_ATLAS_PADDING;
+        region->rect.h -= TEXTURE_ATLAS_PADDING;
+
+        region->texture = page->texture;
+        region->textureWidth = pageSize;
+        region->textureHeight = pageSize;
+
+        SDL_UpdateTexture(page->texture.get(), &region->rect,
+                          converted->pixels, converted->pitch);
+
+        SDL_FreeSurface(converted);
+
+        page->regions.emplace_back(region);
+
+        return region;
+    }
+
+    /**
+     * Move every referenced region on a page into a new, tightly packed page
+     * and release the old one.
+     *
+     * @param index Page index.
+     */
+    auto Repack(size_t index) -> bool
+    {
+        if (!canRepack)
+        {
+            return false;
+        }
+
+        auto &page = pages[index];
+
+        std::vector<std::shared_ptr<TextureAtlasRegion>> regions;
+
+        for (const auto &weakRegion : page.regions)
+        {
+            if (auto region = weakRegion.lock())
+            {
+                regions.emplace_back(region);
+            }
+        }
+
+        std::sort(regions.begin(), regions.end(),
+                  [](const auto &a, const auto &b)
+                  { return a->rect.h > b->rect.h; });
+
+        SkylinePacker packer(pageSize, pageSize);
+
+        std::vector<SDL_Rect> packedRects(regions.size());
+
+        for (size_t i = 0; i < regions.size(); i += 1)
+        {
+            if (!packer.Insert(regions[i]->rect.w + TEXTURE_ATLAS_PADDING,
+                               regions[i]->rect.h + TEXTURE_ATLAS_PADDING,
+                               packedRects[i]))
+            {
+                return false;
+            }
+        }
+
+        auto texture = CreatePageTexture();
+
+        if (texture == nullptr)
+        {
+            return false;
+        }
+
+        auto *previousTarget = SDL_GetRenderTarget(renderer);
+
+        SDL_SetRenderTarget(renderer, texture.get());
+        HANDCRANK_RENDER_STATE_CHANGE();
+
+        SDL_SetTextureBlendMode(page.texture.get(), SDL_BLENDMODE_NONE);
+        HANDCRANK_RENDER_STATE_CHANGE();
+
+        // Unbatched draws tint the shared page texture per object, so clear
+        // the last tint rather than baking it into every region.
+        SDL_SetTextureColorMod(page.texture.get(), SDL_ALPHA_OPAQUE,
+                               SDL_ALPHA_OPAQUE, SDL_ALPHA_OPAQUE);
+        HANDCRANK_RENDER_STATE_CHANGE();
+
+        SDL_SetTextureAlphaMod(page.texture.get(), SDL_ALPHA_OPAQUE);
+        HANDCRANK_RENDER_STATE_CHANGE();
+
+        for (size_t i = 0; i < regions.size(); i += 1)
+        {
+            auto &region = regions[i];
+
+            packedRects[i].w = region->rect.w;
+            packedRects[i].h = region->rect.h;
+
+            SDL_RenderCopy(renderer, page.texture.get(), &region->rect,
+                           &packedRects[i]);
+            HANDCRANK_RENDER_CALL(page.texture.get());
+
+            region->texture = texture;
+            region->rect = packedRects[i];
+        }
+
+        SDL_SetTextureBlendMode(page.texture.get(), SDL_BLENDMODE_BLEND);
+        HANDCRANK_RENDER_STATE_CHANGE();
+
+        SDL_SetRenderTarget(renderer, previousTarget);
+        HANDCRANK_RENDER_STATE_CHANGE();
+
+        page.texture = texture;
+        page.packer = packer;
+        page.regions.assign(regions.begin(), regions.end());
+
+        return true;
+    }
+
+    void Clear() { pages.clear(); }
+
+  private:
+    auto FindPage(int w, int h, SDL_Rect &result) -> Page *
+    {
+        for (auto &page : pages)
+        {
+            if (page.packer.Insert(w, h, result))
+            {
+                return &page;
+            }
+        }
+
+        for (size_t i = 0; i < pages.size(); i += 1)
+        {
+            if (GetFragmentation(i) > fragmentationThreshold && Repack(i) &&
+                pages[i].packer.Insert(w, h, result))
+            {
+                return &pages[i];
+            }
+        }
+
+        auto texture = CreatePageTexture();
+
+        if (texture == nullptr)
+        {
+            return nullptr;
+        }
+
+        pages.push_back({texture, SkylinePacker(pageSize, pageSize), {}});
+
+        if (!pages.back().packer.Insert(w, h, result))
+        {
+            return nullptr;
+        }
+
+        return &pages.back();
+    }
+
+    auto CreatePageTexture() -> std::shared_ptr<SDL_Texture>
+    {
+        auto texture = std::shared_ptr<SDL_Texture>(
+            SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                              canRepack ? SDL_TEXTUREACCESS_TARGET
+                                        : SDL_TEXTUREACCESS_STATIC,
+                              pageSize, pageSize),
+            SDL_DestroyTexture);
+
+        if (texture == nullptr)
+        {
+            SDL_Log("SDL_CreateTexture %s", SDL_GetError());
+
+            return nullptr;
+        }
+
+        SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+
+        if (canRepack)
+        {
+            Uint8 r = 0;
+            Uint8 g = 0;
+            Uint8 b = 0;
+            Uint8 a = 0;
+
+            SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+
+            auto *previousTarget = SDL_GetRenderTarget(renderer);
+
+            SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+            SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+
+            SDL_SetRenderTarget(renderer, texture.get());
+            HANDCRANK_RENDER_STATE_CHANGE();
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            HANDCRANK_RENDER_STATE_CHANGE();
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            HANDCRANK_RENDER_STATE_CHANGE();
+            SDL_RenderClear(renderer);
+            HANDCRANK_RENDER_CALL(nullptr);
+
+            SDL_SetRenderTarget(renderer, previousTarget);
+            HANDCRANK_RENDER_STATE_CHANGE();
+            SDL_SetRenderDrawColor(renderer, r, g, b, a);
+            HANDCRANK_RENDER_STATE_CHANGE();
+            SDL_SetRenderDrawBlendMode(renderer, blendMode);
+            HANDCRANK_RENDER_STATE_CHANGE();
+        }
+        else
+        {
+            std::vector<Uint32> pixels(
+                static_cast<size_t>(pageSize) * pageSize, 0);
+
+            SDL_UpdateTexture(texture.get(), nullptr, pixels.data(),
+                              pageSize * static_cast<int>(sizeof(Uint32)));
+        }
+
+        return texture;
+    }
+};
+
+} // namespace HandcrankEngine
@@ -9,9 +9,20 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <SDL.h>
 #include <SDL_image.h>
 
+#include "JobSystem.hpp"
+#include "ResourceCache.hpp"
+#include "TextureAtlas.hpp"
 #include "Utilities.hpp"
 
 namespace HandcrankEngine
@@ -19,10 +30,43 @@ namespace HandcrankEngine
 
 namespace
 {
-inline std::unordered_map<std::size_t, std::shared_ptr<SDL_Texture>>
-    textureCache =
-        std::unordered_map<std::size_t, std::shared_ptr<SDL_Texture>>();
-}
+inline ResourceCache<SDL_Texture> textureCache;
+
+inline ResourceCache<TextureAtlasRegion> textureRegionCache;
+
+inline std::shared_ptr<SDL_Texture> placeholderTexture;
+
+inline std::unique_ptr<TextureAtlas> textureAtlas;
+
+inline bool isTextureAtlasEnabled = false;
+
+inline int textureAtlasPageSize = DEFAULT_TEXTURE_ATLAS_PAGE_SIZE;
+} // namespace
+
+/**
+ * Result of an asynchronous texture load. Filled in on the main thread once
+ * the decoded image has been uploaded.
+ */
+struct TextureLoadHandle
+{
+    bool isComplete = false;
+
+    std::shared_ptr<SDL_Texture> texture;
+
+    std::shared_ptr<TextureAtlasRegion> textureRegion;
+};
+
+namespace
+{
+inline std::unordered_map<std::size_t, std::shared_ptr<TextureLoadHandle>>
+    pendingTextureLoads = std::unordered_map<
+        std::size_t, std::shared_ptr<TextureLoadHandle>>();
+
+inline std::vector<std::pair<std::size_t, SDL_Surface *>>
+    decodedTextureSurfaces;
+
+inline std::mutex decodedTextureSurfacesMutex;
+} // namespace
 
 struct TextureDeleter
 {
@@ -35,25 +79,273 @@ struct TextureDeleter
     }
 };
 
-inline auto ClearTextureCache() -> void { textureCache.clear(); }
+inline auto ClearTextureCache() -> void
+{
+    textureCache.Clear();
+    textureRegionCache.Clear();
+
+    textureAtlas.reset();
+
+    placeholderTexture.reset();
+
+    pendingTextureLoads.clear();
+
+    std::lock_guard<std::mutex> lock(decodedTextureSurfacesMutex);
+
+    for (const auto &[cacheKey, surface] : decodedTextureSurfaces)
+    {
+        SDL_FreeSurface(surface);
+    }
+
+    decodedTextureSurfaces.clear();
+}
 
 /**
- * Load texture from a path.
+ * Estimate the memory used by a texture.
+ *
+ * @param texture A texture.
+ */
+[[nodiscard]] inline auto GetTextureByteSize(SDL_Texture *texture) -> size_t
+{
+    Uint32 format = 0;
+
+    int width = 0;
+    int height = 0;
+
+    if (SDL_QueryTexture(texture, &format, nullptr, &width, &height) != 0)
+    {
+        return 0;
+    }
+
+    return static_cast<size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+}
+
+/**
+ * Set the memory budget for cached textures and atlas regions. Least
+ * recently used textures that are only referenced by the cache are released
+ * once the budget is exceeded.
+ *
+ * @param bytes Budget in bytes, 0 for unlimited.
+ */
+inline void SetTextureCacheBudget(size_t bytes)
+{
+    textureCache.SetBudget(bytes);
+    textureRegionCache.SetBudget(bytes);
+}
+
+[[nodiscard]] inline auto GetTextureCacheSize() -> size_t
+{
+    return textureCache.GetTotalBytes() + textureRegionCache.GetTotalBytes();
+}
+
+/**
+ * Pack textures loaded from now on into shared atlas pages so draws using
+ * different images can be batched together.
+ *
+ * @param pageSize Width and height of each atlas page.
+ */
+inline void EnableTextureAtlas(int pageSize = DEFAULT_TEXTURE_ATLAS_PAGE_SIZE)
+{
+    isTextureAtlasEnabled = true;
+
+    textureAtlasPageSize = pageSize;
+}
+
+inline void DisableTextureAtlas() { isTextureAtlasEnabled = false; }
+
+[[nodiscard]] inline auto IsTextureAtlasEnabled() -> bool
+{
+    return isTextureAtlasEnabled;
+}
+
+/**
+ * Get the texture atlas for a renderer, creating it if needed.
+ *
+ * @param renderer A structure representing rendering state.
+ */
+[[nodiscard]] inline auto GetTextureAtlas(SDL_Renderer *renderer)
+    -> TextureAtlas &
+{
+    if (!textureAtlas || textureAtlas->GetRenderer() != renderer)
+    {
+        textureAtlas =
+            std::make_unique<TextureAtlas>(renderer, textureAtlasPageSize);
+    }
+
+    return *textureAtlas;
+}
+
+/**
+ * Drop cached atlas regions that are no longer used by anything else. Their
+ * space is reclaimed the next time their page is repacked.
+ */
+inline void ReleaseUnusedTextureRegions()
+{
+    textureRegionCache.EvictUnused();
+}
+
+/**
+ * Add a surface to the texture atlas and cache the resulting region. The
+ * surface is freed.
+ *
+ * @param renderer A structure representing rendering state.
+ * @param cacheKey Key to cache the region under.
+ * @param surface Surface to add.
+ */
+inline auto CacheTextureRegion(SDL_Renderer *renderer, std::size_t cacheKey,
+                               SDL_Surface *surface)
+    -> std::shared_ptr<TextureAtlasRegion>
+{
+    if (surface == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto region = GetTextureAtlas(renderer).Add(surface);
+
+    SDL_FreeSurface(surface);
+
+    if (region == nullptr)
+    {
+        return nullptr;
+    }
+
+    textureRegionCache.Insert(
+        cacheKey, region,
+        static_cast<size_t>(region->rect.w) * region->rect.h * 4);
+
+    return region;
+}
+
+/**
+ * Load texture atlas region from a path.
  *
  * @param renderer A structure representing rendering state.
  * @param path File path to texture file.
  */
+inline auto LoadCachedTextureRegion(SDL_Renderer *renderer, const char *path)
+    -> std::shared_ptr<TextureAtlasRegion>
+{
+    auto cacheKey = std::hash<std::string_view>{}(std::string_view(path));
 
-inline auto LoadCachedTexture(SDL_Renderer *renderer, const char *path)
-    -> SDL_Texture *
+    if (auto region = textureRegionCache.Find(cacheKey))
+    {
+        return region;
+    }
+
+    return CacheTextureRegion(renderer, cacheKey, IMG_Load(path));
+}
+
+/**
+ * Load texture atlas region from a path.
+ *
+ * @param renderer A structure representing rendering state.
+ * @param path File path to texture file.
+ * @param color The color to use as the transparent color key.
+ */
+inline auto LoadCachedTransparentTextureRegion(SDL_Renderer *renderer,
+                                               const char *path,
+                                               const SDL_Color colorKey)
+    -> std::shared_ptr<TextureAtlasRegion>
 {
     auto cacheKey = std::hash<std::string_view>{}(std::string_view(path));
 
-    auto match = textureCache.find(cacheKey);
+    if (auto region = textureRegionCache.Find(cacheKey))
+    {
+        return region;
+    }
+
+    auto *surface = IMG_Load(path);
 
-    if (match != textureCache.end())
+    if (surface == nullptr)
     {
-        return match->second.get();
+        return nullptr;
+    }
+
+    SDL_SetColorKey(
+        surface, SDL_TRUE,
+        SDL_MapRGB(surface->format, colorKey.r, colorKey.g, colorKey.b));
+
+    return CacheTextureRegion(renderer, cacheKey, surface);
+}
+
+/**
+ * Load texture atlas region from a read-only buffer.
+ *
+ * @param renderer A structure representing rendering state.
+ * @param mem A pointer to a read-only buffer.
+ * @param size The buffer size, in bytes.
+ */
+inline auto LoadCachedTextureRegion(SDL_Renderer *renderer, const void *mem,
+                                    int size)
+    -> std::shared_ptr<TextureAtlasRegion>
+{
+    auto cacheKey = MemHash(mem, size);
+
+    if (auto region = textureRegionCache.Find(cacheKey))
+    {
+        return region;
+    }
+
+    auto *rw = SDL_RWFromConstMem(mem, size);
+
+    return CacheTextureRegion(renderer, cacheKey,
+                              IMG_isSVG(rw) == SDL_TRUE ? IMG_LoadSVG_RW(rw)
+                                                        : IMG_Load_RW(rw, 1));
+}
+
+/**
+ * Load texture atlas region from a read-only buffer.
+ *
+ * @param renderer A structure representing rendering state.
+ * @param mem A pointer to a read-only buffer.
+ * @param size The buffer size, in bytes.
+ * @param color The color to use as the transparent color key.
+ */
+inline auto LoadCachedTransparentTextureRegion(SDL_Renderer *renderer,
+                                               const void *mem, int size,
+                                               const SDL_Color colorKey)
+    -> std::shared_ptr<TextureAtlasRegion>
+{
+    auto cacheKey = MemHash(mem, size);
+
+    if (auto region = textureRegionCache.Find(cacheKey))
+    {
+        return region;
+    }
+
+    auto *rw = SDL_RWFromConstMem(mem, size);
+
+    auto *surface =
+        IMG_isSVG(rw) == SDL_TRUE ? IMG_LoadSVG_RW(rw) : IMG_Load_RW(rw, 1);
+
+    if (surface == nullptr)
+    {
+        return nullptr;
+    }
+
+    SDL_SetColorKey(
+        surface, SDL_TRUE,
+        SDL_MapRGB(surface->format, colorKey.r, colorKey.g, colorKey.b));
+
+    return CacheTextureRegion(renderer, cacheKey, surface);
+}
+
+/**
+ * Load texture from a path.
+ *
+ * @param renderer A structure representing rendering state.
+ * @param path File path to texture file.
+ */
+
+inline auto LoadCachedSharedTexture(SDL_Renderer *renderer, const char *path)
+    -> std::shared_ptr<SDL_Texture>
+{
+    auto cacheKey = std::hash<std::string_view>{}(std::string_view(path));
+
+    if (auto texture = textureCache.Find(cacheKey))
+    {
+        return texture;
     }
 
     auto *surface = IMG_Load(path);
@@ -73,9 +365,9 @@ inline auto LoadCachedTexture(SDL_Renderer *renderer, const char *path)
         return nullptr;
     }
 
-    textureCache.insert_or_assign(cacheKey, texture);
+    textureCache.Insert(cacheKey, texture, GetTextureByteSize(texture.get()));
 
-    return texture.get();
+    return texture;
 }
 
 /**
@@ -86,18 +378,16 @@ inline auto LoadCachedTexture(SDL_Renderer *renderer, const char *path)
  * @param color The color to use as the transparent color key.
  */
 
-inline auto LoadCachedTransparentTexture(SDL_Renderer *renderer,
-                                         const char *path,
-                                         const SDL_Color colorKey)
-    -> SDL_Texture *
+inline auto LoadCachedSharedTransparentTexture(SDL_Renderer *renderer,
+                                               const char *path,
+                                               const SDL_Color colorKey)
+    -> std::shared_ptr<SDL_Texture>
 {
     auto cacheKey = std::hash<std::string_view>{}(std::string_view(path));
 
-    auto match = textureCache.find(cacheKey);
-
-    if (match != textureCache.end())
+    if (auto texture = textureCache.Find(cacheKey))
     {
-        return match->second.get();
+        return texture;
     }
 
     auto *surface = IMG_Load(path);
@@ -121,9 +411,214 @@ inline auto LoadCachedTransparentTexture(SDL_Renderer *renderer,
         return nullptr;
     }
 
-    textureCache.insert_or_assign(cacheKey, texture);
+    textureCache.Insert(cacheKey, texture, GetTextureByteSize(texture.get()));
 
-    return texture.get();
+    return texture;
+}
+
+/**
+ * Queue a surface decode on the job system, or return a completed handle if
+ * the texture is already cached.
+ *
+ * @param jobSystem Job system to decode on.
+ * @param cacheKey Key to cache the texture under.
+ * @param decode Called on a worker thread, returns the decoded surface.
+ */
+inline auto
+QueueTextureDecode(JobSystem &jobSystem, std::size_t cacheKey,
+                   std::function<SDL_Surface *()> decode)
+    -> std::shared_ptr<TextureLoadHandle>
+{
+    if (auto match = pendingTextureLoads.find(cacheKey);
+        match != pendingTextureLoads.end())
+    {
+        return match->second;
+    }
+
+    auto handle = std::make_shared<TextureLoadHandle>();
+
+    if (IsTextureAtlasEnabled())
+    {
+        if (auto region = textureRegionCache.Find(cacheKey))
+        {
+            handle->isComplete = true;
+            handle->textureRegion = region;
+            handle->texture = region->texture;
+
+            return handle;
+        }
+    }
+    else if (auto texture = textureCache.Find(cacheKey))
+    {
+        handle->isComplete = true;
+        handle->texture = texture;
+
+        return handle;
+    }
+
+    pendingTextureLoads.insert_or_assign(cacheKey, handle);
+
+    auto job = [cacheKey, decode = std::move(decode)]
+    {
+        auto *surface = decode();
+
+        std::lock_guard<std::mutex> lock(decodedTextureSurfacesMutex);
+
+        decodedTextureSurfaces.emplace_back(cacheKey, surface);
+    };
+
+    // Without worker threads nothing would drain the submitted job, so
+    // decode now and let UploadDecodedTextures pick it up as usual.
+    if (jobSystem.GetThreadCount() <= 1)
+    {
+        job();
+
+        return handle;
+    }
+
+    jobSystem.Submit(std::move(job));
+
+    return handle;
+}
+
+/**
+ * Decode texture from a path on the job system. The texture is uploaded
+ * by UploadDecodedTextures at the start of a later frame.
+ *
+ * @param jobSystem Job system to decode on.
+ * @param path File path to texture file.
+ */
+inline auto LoadCachedTextureAsync(JobSystem &jobSystem, const char *path)
+    -> std::shared_ptr<TextureLoadHandle>
+{
+    return QueueTextureDecode(
+        jobSystem, std::hash<std::string_view>{}(std::string_view(path)),
+        [path = std::string(path)] { return IMG_Load(path.c_str()); });
+}
+
+/**
+ * Decode texture from a read-only buffer on the job system. The buffer must
+ * stay valid until the load completes.
+ *
+ * @param jobSystem Job system to decode on.
+ * @param mem A pointer to a read-only buffer.
+ * @param size The buffer size, in bytes.
+ */
+inline auto LoadCachedTextureAsync(JobSystem &jobSystem, const void *mem,
+                                   int size)
+    -> std::shared_ptr<TextureLoadHandle>
+{
+    return QueueTextureDecode(jobSystem, MemHash(mem, size),
+                              [mem, size]
+                              {
+                                  auto *rw = SDL_RWFromConstMem(mem, size);
+
+                                  return IMG_isSVG(rw) == SDL_TRUE
+                                             ? IMG_LoadSVG_RW(rw)
+                                             : IMG_Load_RW(rw, 1);
+                              });
+}
+
+/**
+ * Upload surfaces decoded since the last call and complete their handles.
+ * Must be called on the thread that owns the renderer.
+ *
+ * @param renderer A structure representing rendering state.
+ */
+inline void UploadDecodedTextures(SDL_Renderer *renderer)
+{
+    std::vector<std::pair<std::size_t, SDL_Surface *>> surfaces;
+
+    {
+        std::lock_guard<std::mutex> lock(decodedTextureSurfacesMutex);
+
+        if (decodedTextureSurfaces.empty())
+        {
+            return;
+        }
+
+        surfaces.swap(decodedTextureSurfaces);
+    }
+
+    for (const auto &[cacheKey, surface] : surfaces)
+    {
+        auto match = pendingTextureLoads.find(cacheKey);
+
+        if (match == pendingTextureLoads.end())
+        {
+            SDL_FreeSurface(surface);
+
+            continue;
+        }
+
+        auto handle = match->second;
+
+        pendingTextureLoads.erase(match);
+
+        handle->isComplete = true;
+
+        if (surface == nullptr)
+        {
+            continue;
+        }
+
+        if (IsTextureAtlasEnabled())
+        {
+            handle->textureRegion =
+                CacheTextureRegion(renderer, cacheKey, surface);
+
+            if (handle->textureRegion != nullptr)
+            {
+                handle->texture = handle->textureRegion->texture;
+            }
+
+            continue;
+        }
+
+        auto texture = std::shared_ptr<SDL_Texture>(
+            SDL_CreateTextureFromSurface(renderer, surface), TextureDeleter{});
+
+        SDL_FreeSurface(surface);
+
+        if (texture != nullptr)
+        {
+            textureCache.Insert(cacheKey, texture,
+                                GetTextureByteSize(texture.get()));
+
+            handle->texture = texture;
+        }
+    }
+}
+
+/**
+ * Get a small grey texture to draw while a texture is still loading.
+ *
+ * @param renderer A structure representing rendering state.
+ */
+inline auto GetPlaceholderTexture(SDL_Renderer *renderer) -> SDL_Texture *
+{
+    if (placeholderTexture != nullptr)
+    {
+        return placeholderTexture.get();
+    }
+
+    auto *surface =
+        SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_RGBA32);
+
+    if (surface == nullptr)
+    {
+        return nullptr;
+    }
+
+    SDL_FillRect(surface, nullptr,
+                 SDL_MapRGBA(surface->format, 128, 128, 128, 128));
+
+    placeholderTexture = std::shared_ptr<SDL_Texture>(
+        SDL_CreateTextureFromSurface(renderer, surface), TextureDeleter{});
+
+    SDL_FreeSurface(surface);
+
+    return placeholderTexture.get();
 }
 
 /**
@@ -133,16 +628,14 @@ inline auto LoadCachedTransparentTexture(SDL_Renderer *renderer,
  * @param mem A pointer to a read-only buffer.
  * @param size The buffer size, in bytes.
  */
-inline auto LoadCachedTexture(SDL_Renderer *renderer, const void *mem, int size)
-    -> SDL_Texture *
+inline auto LoadCachedSharedTexture(SDL_Renderer *renderer, const void *mem,
+                                    int size) -> std::shared_ptr<SDL_Texture>
 {
     auto cacheKey = MemHash(mem, size);
 
-    auto match = textureCache.find(cacheKey);
-
-    if (match != textureCache.end())
+    if (auto texture = textureCache.Find(cacheKey))
     {
-        return match->second.get();
+        return texture;
     }
 
     auto *rw = SDL_RWFromConstMem(mem, size);
@@ -165,9 +658,9 @@ inline auto LoadCachedTexture(SDL_Renderer *renderer, const void *mem, int size)
         return nullptr;
     }
 
-    textureCache.insert_or_assign(cacheKey, texture);
+    textureCache.Insert(cacheKey, texture, GetTextureByteSize(texture.get()));
 
-    return texture.get();
+    return texture;
 }
 
 /**
@@ -178,18 +671,16 @@ inline auto LoadCachedTexture(SDL_Renderer *renderer, const void *mem, int size)
  * @param size The buffer size, in bytes.
  * @param color The color to use as the transparent color key.
  */
-inline auto LoadCachedTransparentTexture(SDL_Renderer *renderer,
-                                         const void *mem, int size,
-                                         const SDL_Color colorKey)
-    -> SDL_Texture *
+inline auto LoadCachedSharedTransparentTexture(SDL_Renderer *renderer,
+                                               const void *mem, int size,
+                                               const SDL_Color colorKey)
+    -> std::shared_ptr<SDL_Texture>
 {
     auto cacheKey = MemHash(mem, size);
 
-    auto match = textureCache.find(cacheKey);
-
-    if (match != textureCache.end())
+    if (auto texture = textureCache.Find(cacheKey))
     {
-        return match->second.get();
+        return texture;
     }
 
     auto *rw = SDL_RWFromConstMem(mem, size);
@@ -216,7 +707,82 @@ inline auto LoadCachedTransparentTexture(SDL_Renderer *renderer,
         return nullptr;
     }
 
-    textureCache.insert_or_assign(cacheKey, texture);
+    textureCache.Insert(cacheKey, texture, GetTextureByteSize(texture.get()));
+
+    return texture;
+}
+
+/**
+ * Load texture from a path. The cache keeps ownership of the texture and
+ * never evicts it, use LoadCachedSharedTexture for textures that can be
+ * evicted once unused when a cache budget is set.
+ *
+ * @param renderer A structure representing rendering state.
+ * @param path File path to texture file.
+ */
+inline auto LoadCachedTexture(SDL_Renderer *renderer, const char *path)
+    -> SDL_Texture *
+{
+    auto texture = LoadCachedSharedTexture(renderer, path);
+
+    textureCache.Pin(texture);
+
+    return texture.get();
+}
+
+/**
+ * Load texture from a path.
+ *
+ * @param renderer A structure representing rendering state.
+ * @param path File path to texture file.
+ * @param color The color to use as the transparent color key.
+ */
+inline auto LoadCachedTransparentTexture(SDL_Renderer *renderer,
+                                         const char *path,
+                                         const SDL_Color colorKey)
+    -> SDL_Texture *
+{
+    auto texture = LoadCachedSharedTransparentTexture(renderer, path, colorKey);
+
+    textureCache.Pin(texture);
+
+    return texture.get();
+}
+
+/**
+ * Load texture from a read-only buffer.
+ *
+ * @param renderer A structure representing rendering state.
+ * @param mem A pointer to a read-only buffer.
+ * @param size The buffer size, in bytes.
+ */
+inline auto LoadCachedTexture(SDL_Renderer *renderer, const void *mem, int size)
+    -> SDL_Texture *
+{
+    auto texture = LoadCachedSharedTexture(renderer, mem, size);
+
+    textureCache.Pin(texture);
+
+    return texture.get();
+}
+
+/**
+ * Load texture from a read-only buffer.
+ *
+ * @param renderer A structure representing rendering state.
+ * @param mem A pointer to a read-only buffer.
+ * @param size The buffer size, in bytes.
+ * @param color The color to use as the transparent color key.
+ */
+inline auto LoadCachedTransparentTexture(SDL_Renderer *renderer,
+                                         const void *mem, int size,
+                                         const SDL_Color colorKey)
+    -> SDL_Texture *
+{
+    auto texture =
+        LoadCachedSharedTransparentTexture(renderer, mem, size, colorKey);
+
+    textureCache.Pin(texture);
 
     return texture.get();
 }
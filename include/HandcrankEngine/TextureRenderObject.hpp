@@ -23,12 +23,23 @@ class TextureRenderObject : public RenderObject
   protected:
     SDL_Texture *texture = nullptr;
 
+    std::shared_ptr<SDL_Texture> sharedTexture;
+
+    std::shared_ptr<TextureAtlasRegion> textureRegion;
+
+    std::shared_ptr<TextureLoadHandle> textureLoadHandle;
+
     int textureWidth = 0;
     int textureHeight = 0;
 
   public:
     using RenderObject::RenderObject;
 
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(TextureRenderObject);
+    }
+
     /**
      * Set texture from an existing texture reference.
      *
@@ -38,9 +49,66 @@ class TextureRenderObject : public RenderObject
     {
         this->texture = texture;
 
+        sharedTexture = nullptr;
+        textureRegion = nullptr;
+        textureLoadHandle = nullptr;
+
+        UpdateRectSizeFromTexture();
+    }
+
+    /**
+     * Set texture from a shared texture, keeping it alive for as long as
+     * this object uses it.
+     *
+     * @param texture A texture.
+     */
+    void SetSharedTexture(const std::shared_ptr<SDL_Texture> &texture)
+    {
+        this->texture = texture.get();
+
+        sharedTexture = texture;
+        textureRegion = nullptr;
+        textureLoadHandle = nullptr;
+
         UpdateRectSizeFromTexture();
     }
 
+    /**
+     * Set texture from a region of a texture atlas.
+     *
+     * @param textureRegion A texture atlas region.
+     */
+    void SetTextureRegion(
+        const std::shared_ptr<TextureAtlasRegion> &textureRegion)
+    {
+        this->textureRegion = textureRegion;
+
+        sharedTexture = nullptr;
+        textureLoadHandle = nullptr;
+
+        // Repacking the atlas moves the region to a new page, so the page is
+        // looked up through the region at draw time instead.
+        texture = nullptr;
+
+        UpdateRectSizeFromTexture();
+    }
+
+    [[nodiscard]] auto GetTextureRegion() const
+        -> const std::shared_ptr<TextureAtlasRegion> &
+    {
+        return textureRegion;
+    }
+
+    /**
+     * Get the texture to draw with, which is the atlas page for atlas
+     * regions.
+     */
+    [[nodiscard]] auto GetRenderTexture() const -> SDL_Texture *
+    {
+        return textureRegion != nullptr ? textureRegion->texture.get()
+                                        : texture;
+    }
+
     /**
      * Load texture from a path.
      *
@@ -49,9 +117,24 @@ class TextureRenderObject : public RenderObject
      */
     void LoadTexture(SDL_Renderer *renderer, const char *path)
     {
-        texture = LoadCachedTexture(renderer, path);
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer(
+                [self = shared_from_this(), this, renderer,
+                 path = std::string(path)]
+                { LoadTexture(renderer, path.c_str()); });
 
-        UpdateRectSizeFromTexture();
+            return;
+        }
+
+        if (IsTextureAtlasEnabled())
+        {
+            SetTextureRegion(LoadCachedTextureRegion(renderer, path));
+
+            return;
+        }
+
+        SetSharedTexture(LoadCachedSharedTexture(renderer, path));
     }
 
     /**
@@ -64,9 +147,26 @@ class TextureRenderObject : public RenderObject
     void LoadTransparentTexture(SDL_Renderer *renderer, const char *path,
                                 const SDL_Color colorKey)
     {
-        texture = LoadCachedTransparentTexture(renderer, path, colorKey);
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer(
+                [self = shared_from_this(), this, renderer,
+                 path = std::string(path), colorKey]
+                { LoadTransparentTexture(renderer, path.c_str(), colorKey); });
 
-        UpdateRectSizeFromTexture();
+            return;
+        }
+
+        if (IsTextureAtlasEnabled())
+        {
+            SetTextureRegion(
+                LoadCachedTransparentTextureRegion(renderer, path, colorKey));
+
+            return;
+        }
+
+        SetSharedTexture(
+            LoadCachedSharedTransparentTexture(renderer, path, colorKey));
     }
 
     /**
@@ -78,9 +178,22 @@ class TextureRenderObject : public RenderObject
      */
     void LoadTexture(SDL_Renderer *renderer, const void *mem, int size)
     {
-        texture = LoadCachedTexture(renderer, mem, size);
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this, renderer, mem, size]
+                        { LoadTexture(renderer, mem, size); });
 
-        UpdateRectSizeFromTexture();
+            return;
+        }
+
+        if (IsTextureAtlasEnabled())
+        {
+            SetTextureRegion(LoadCachedTextureRegion(renderer, mem, size));
+
+            return;
+        }
+
+        SetSharedTexture(LoadCachedSharedTexture(renderer, mem, size));
     }
 
     /**
@@ -94,9 +207,107 @@ class TextureRenderObject : public RenderObject
     void LoadTransparentTexture(SDL_Renderer *renderer, const void *mem,
                                 int size, const SDL_Color colorKey)
     {
-        texture = LoadCachedTransparentTexture(renderer, mem, size, colorKey);
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer(
+                [self = shared_from_this(), this, renderer, mem, size,
+                 colorKey]
+                { LoadTransparentTexture(renderer, mem, size, colorKey); });
 
-        UpdateRectSizeFromTexture();
+            return;
+        }
+
+        if (IsTextureAtlasEnabled())
+        {
+            SetTextureRegion(LoadCachedTransparentTextureRegion(
+                renderer, mem, size, colorKey));
+
+            return;
+        }
+
+        SetSharedTexture(
+            LoadCachedSharedTransparentTexture(renderer, mem, size, colorKey));
+    }
+
+    /**
+     * Load texture from a path without blocking. The image is decoded on the
+     * job system and a placeholder is drawn until it has been uploaded.
+     *
+     * @param game Game to decode and upload the texture with.
+     * @param path File path to texture file.
+     * @param placeholder Texture to draw while loading. Defaults to a
+     * translucent grey texture.
+     */
+    void LoadTextureAsync(Game *game, const char *path,
+                          SDL_Texture *placeholder = nullptr)
+    {
+        if (game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this, game,
+                         path = std::string(path), placeholder]
+                        { LoadTextureAsync(game, path.c_str(), placeholder); });
+
+            return;
+        }
+
+        SetTextureLoadHandle(
+            game, LoadCachedTextureAsync(game->GetJobSystem(), path),
+            placeholder);
+    }
+
+    /**
+     * Load texture from a read-only buffer without blocking. The buffer must
+     * stay valid until the texture has loaded.
+     *
+     * @param game Game to decode and upload the texture with.
+     * @param mem A pointer to a read-only buffer.
+     * @param size The buffer size, in bytes.
+     * @param placeholder Texture to draw while loading. Defaults to a
+     * translucent grey texture.
+     */
+    void LoadTextureAsync(Game *game, const void *mem, int size,
+                          SDL_Texture *placeholder = nullptr)
+    {
+        if (game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this, game, mem, size,
+                         placeholder]
+                        { LoadTextureAsync(game, mem, size, placeholder); });
+
+            return;
+        }
+
+        SetTextureLoadHandle(
+            game, LoadCachedTextureAsync(game->GetJobSystem(), mem, size),
+            placeholder);
+    }
+
+    [[nodiscard]] auto IsTextureLoading() const -> bool
+    {
+        return textureLoadHandle != nullptr;
+    }
+
+    /**
+     * Swap the placeholder for the loaded texture once an asynchronous load
+     * has completed.
+     */
+    void UpdateTextureFromLoadHandle()
+    {
+        if (textureLoadHandle == nullptr || !textureLoadHandle->isComplete)
+        {
+            return;
+        }
+
+        auto handle = std::move(textureLoadHandle);
+
+        if (handle->textureRegion != nullptr)
+        {
+            SetTextureRegion(handle->textureRegion);
+        }
+        else
+        {
+            SetSharedTexture(handle->texture);
+        }
     }
 
     /**
@@ -107,13 +318,49 @@ class TextureRenderObject : public RenderObject
      */
     void LoadSVGString(SDL_Renderer *renderer, const std::string &content)
     {
-        texture = LoadCachedTexture(renderer, content.c_str(), content.size());
+        // Defer with a copy, as the buffer must outlive the deferred load.
+        if (game != nullptr && game->IsUpdatingInParallel())
+        {
+            game->Defer([self = shared_from_this(), this, renderer, content]
+                        { LoadSVGString(renderer, content); });
 
-        UpdateRectSizeFromTexture();
+            return;
+        }
+
+        LoadTexture(renderer, content.c_str(), content.size());
+    }
+
+    void SetTextureLoadHandle(Game *game,
+                              const std::shared_ptr<TextureLoadHandle> &handle,
+                              SDL_Texture *placeholder)
+    {
+        sharedTexture = nullptr;
+        textureRegion = nullptr;
+
+        texture = placeholder != nullptr
+                      ? placeholder
+                      : GetPlaceholderTexture(game->GetRenderer());
+
+        textureWidth = 0;
+        textureHeight = 0;
+
+        textureLoadHandle = handle;
+
+        UpdateTextureFromLoadHandle();
     }
 
     void UpdateRectSizeFromTexture()
     {
+        if (textureRegion != nullptr)
+        {
+            textureWidth = textureRegion->rect.w;
+            textureHeight = textureRegion->rect.h;
+
+            SetDimension(textureWidth, textureHeight);
+
+            return;
+        }
+
         if (texture == nullptr)
         {
             return;
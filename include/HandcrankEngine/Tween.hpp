@@ -0,0 +1,826 @@
+// Handcrank Engine - https://handcrankengine.com/
+//
+// ░█░█░█▀█░█▀█░█▀▄░█▀▀░█▀▄░█▀█░█▀█░█░█░░░█▀▀░█▀█░█▀▀░▀█▀░█▀█░█▀▀
+// ░█▀█░█▀█░█░█░█░█░█░░░█▀▄░█▀█░█░█░█▀▄░░░█▀▀░█░█░█░█░░█░░█░█░█▀▀
+// ░▀░▀░▀░▀░▀░▀░▀▀░░▀▀▀░▀░▀░▀░▀░▀░▀░▀░▀░░░▀▀▀░▀░▀░▀▀▀░▀▀▀░▀░▀░▀▀▀
+//
+// Copyright (c) Scott Doxey. All Rights Reserved. Licensed under the MIT
+// License. See LICENSE in the project root for license information.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace HandcrankEngine
+{
+
+class Game;
+class RenderObject;
+
+inline const float TWEEN_PI = 3.14159265358979F;
+
+inline const float TWEEN_BACK_OVERSHOOT = 1.70158F;
+
+inline const size_t DEFAULT_TWEEN_POOL_SIZE = 64;
+
+enum class Easing : uint8_t
+{
+    LINEAR,
+    EASE_IN_QUAD,
+    EASE_OUT_QUAD,
+    EASE_IN_OUT_QUAD,
+    EASE_IN_CUBIC,
+    EASE_OUT_CUBIC,
+    EASE_IN_OUT_CUBIC,
+    EASE_IN_SINE,
+    EASE_OUT_SINE,
+    EASE_IN_OUT_SINE,
+    EASE_IN_BACK,
+    EASE_OUT_BACK,
+    EASE_OUT_BOUNCE,
+    COUNT
+};
+
+inline const size_t EASING_COUNT = static_cast<size_t>(Easing::COUNT);
+
+/**
+ * What a tween writes its value to.
+ */
+enum class TweenProperty : uint8_t
+{
+    // A float the tween points at.
+    VALUE,
+
+    // The x position of a render object.
+    X,
+
+    // The y position of a render object.
+    Y,
+
+    // The scale of a render object.
+    SCALE
+};
+
+/**
+ * Evaluate an easing curve known at compile time.
+ *
+ * @param t Progress from 0 to 1.
+ */
+template <Easing easing> inline auto Ease(float t) -> float
+{
+    if constexpr (easing == Easing::EASE_IN_QUAD)
+    {
+        return t * t;
+    }
+    else if constexpr (easing == Easing::EASE_OUT_QUAD)
+    {
+        return t * (2 - t);
+    }
+    else if constexpr (easing == Easing::EASE_IN_OUT_QUAD)
+    {
+        return t < 0.5F ? 2 * t * t : -1 + ((4 - 2 * t) * t);
+    }
+    else if constexpr (easing == Easing::EASE_IN_CUBIC)
+    {
+        return t * t * t;
+    }
+    else if constexpr (easing == Easing::EASE_OUT_CUBIC)
+    {
+        auto u = t - 1;
+
+        return (u * u * u) + 1;
+    }
+    else if constexpr (easing == Easing::EASE_IN_OUT_CUBIC)
+    {
+        auto u = (2 * t) - 2;
+
+        return t < 0.5F ? 4 * t * t * t : (0.5F * u * u * u) + 1;
+    }
+    else if constexpr (easing == Easing::EASE_IN_SINE)
+    {
+        return 1 - std::cos(t * TWEEN_PI / 2);
+    }
+    else if constexpr (easing == Easing::EASE_OUT_SINE)
+    {
+        return std::sin(t * TWEEN_PI / 2);
+    }
+    else if constexpr (easing == Easing::EASE_IN_OUT_SINE)
+    {
+        return (1 - std::cos(t * TWEEN_PI)) / 2;
+    }
+    else if constexpr (easing == Easing::EASE_IN_BACK)
+    {
+        return ((TWEEN_BACK_OVERSHOOT + 1) * t * t * t) -
+               (TWEEN_BACK_OVERSHOOT * t * t);
+    }
+    else if constexpr (easing == Easing::EASE_OUT_BACK)
+    {
+        auto u = t - 1;
+
+        return 1 + ((TWEEN_BACK_OVERSHOOT + 1) * u * u * u) +
+               (TWEEN_BACK_OVERSHOOT * u * u);
+    }
+    else if constexpr (easing == Easing::EASE_OUT_BOUNCE)
+    {
+        const auto n = 7.5625F;
+        const auto d = 2.75F;
+
+        if (t < 1 / d)
+        {
+            return n * t * t;
+        }
+
+        if (t < 2 / d)
+        {
+            t -= 1.5F / d;
+
+            return (n * t * t) + 0.75F;
+        }
+
+        if (t < 2.5F / d)
+        {
+            t -= 2.25F / d;
+
+            return (n * t * t) + 0.9375F;
+        }
+
+        t -= 2.625F / d;
+
+        return (n * t * t) + 0.984375F;
+    }
+    else
+    {
+        return t;
+    }
+}
+
+/**
+ * Evaluate an easing curve.
+ *
+ * @param easing Easing curve.
+ * @param t Progress from 0 to 1.
+ */
+inline auto ApplyEasing(Easing easing, float t) -> float
+{
+    switch (easing)
+    {
+    case Easing::EASE_IN_QUAD:
+        return Ease<Easing::EASE_IN_QUAD>(t);
+    case Easing::EASE_OUT_QUAD:
+        return Ease<Easing::EASE_OUT_QUAD>(t);
+    case Easing::EASE_IN_OUT_QUAD:
+        return Ease<Easing::EASE_IN_OUT_QUAD>(t);
+    case Easing::EASE_IN_CUBIC:
+        return Ease<Easing::EASE_IN_CUBIC>(t);
+    case Easing::EASE_OUT_CUBIC:
+        return Ease<Easing::EASE_OUT_CUBIC>(t);
+    case Easing::EASE_IN_OUT_CUBIC:
+        return Ease<Easing::EASE_IN_OUT_CUBIC>(t);
+    case Easing::EASE_IN_SINE:
+        return Ease<Easing::EASE_IN_SINE>(t);
+    case Easing::EASE_OUT_SINE:
+        return Ease<Easing::EASE_OUT_SINE>(t);
+    case Easing::EASE_IN_OUT_SINE:
+        return Ease<Easing::EASE_IN_OUT_SINE>(t);
+    case Easing::EASE_IN_BACK:
+        return Ease<Easing::EASE_IN_BACK>(t);
+    case Easing::EASE_OUT_BACK:
+        return Ease<Easing::EASE_OUT_BACK>(t);
+    case Easing::EASE_OUT_BOUNCE:
+        return Ease<Easing::EASE_OUT_BOUNCE>(t);
+    default:
+        return t;
+    }
+}
+
+// Defined in HandcrankEngine.hpp once RenderObject is complete.
+inline auto GetTweenProperty(const RenderObject *object,
+                             TweenProperty property) -> float;
+inline void SetTweenProperty(RenderObject *object, TweenProperty property,
+                             float value);
+inline auto IsTweenObjectDestroyed(const RenderObject *object) -> bool;
+inline auto IsTweenGameUpdatingInParallel(const Game *game) -> bool;
+inline void DeferTweenCommand(Game *game, std::function<void()> command);
+
+/**
+ * Everything needed to start a tween, filled in by TweenBuilder.
+ */
+struct TweenDefinition
+{
+    float *target = nullptr;
+
+    RenderObject *object = nullptr;
+
+    TweenProperty property = TweenProperty::VALUE;
+
+    float start = 0;
+    float end = 0;
+
+    bool hasStart = false;
+
+    double duration = 0;
+    double delay = 0;
+
+    Easing easing = Easing::LINEAR;
+
+    std::function<void()> onComplete;
+};
+
+/**
+ * Tweens that share an easing curve, stored as one array per field so a
+ * frame of them can be stepped in a single loop.
+ */
+struct TweenPool
+{
+    std::vector<float *> targets;
+    std::vector<RenderObject *> objects;
+    std::vector<TweenProperty> properties;
+
+    std::vector<float> starts;
+    std::vector<float> changes;
+    std::vector<float> inverseDurations;
+    std::vector<float> elapsed;
+
+    // 0 for tweens without a From value that are still waiting out their
+    // delay. Their start value is read when they first run, and until then
+    // their change holds the end value.
+    std::vector<uint8_t> hasStarts;
+
+    size_t pendingStartCount = 0;
+
+    // Eased values of the current step, written to targets afterwards.
+    std::vector<float> values;
+
+    std::vector<std::function<void()>> onCompletes;
+
+    [[nodiscard]] auto GetCount() const -> size_t { return starts.size(); }
+
+    void Reserve(size_t count)
+    {
+        targets.reserve(count);
+        objects.reserve(count);
+        properties.reserve(count);
+        starts.reserve(count);
+        changes.reserve(count);
+        inverseDurations.reserve(count);
+        elapsed.reserve(count);
+        hasStarts.reserve(count);
+        values.reserve(count);
+        onCompletes.reserve(count);
+    }
+
+    void Add(TweenDefinition &&definition, float start, bool hasStart)
+    {
+        targets.push_back(definition.target);
+        objects.push_back(definition.object);
+        properties.push_back(definition.property);
+
+        starts.push_back(hasStart ? start : 0);
+        changes.push_back(hasStart ? definition.end - start : definition.end);
+
+        hasStarts.push_back(hasStart ? 1 : 0);
+
+        if (!hasStart)
+        {
+            pendingStartCount += 1;
+        }
+
+        // A tween without a duration completes on its first step.
+        inverseDurations.push_back(
+            definition.duration > 0
+                ? static_cast<float>(1 / definition.duration)
+                : std::numeric_limits<float>::max());
+
+        // Delayed tweens start with negative elapsed time and aren't written
+        // until it reaches 0.
+        elapsed.push_back(static_cast<float>(-definition.delay));
+
+        values.push_back(start);
+
+        onCompletes.push_back(std::move(definition.onComplete));
+    }
+
+    /**
+     * Move the last tween into a slot and shrink every array by one.
+     *
+     * @param index Slot to overwrite.
+     */
+    void SwapRemove(size_t index)
+    {
+        auto last = GetCount() - 1;
+
+        if (hasStarts[index] == 0)
+        {
+            pendingStartCount -= 1;
+        }
+
+        if (index != last)
+        {
+            targets[index] = targets[last];
+            objects[index] = objects[last];
+            properties[index] = properties[last];
+            starts[index] = starts[last];
+            changes[index] = changes[last];
+            inverseDurations[index] = inverseDurations[last];
+            elapsed[index] = elapsed[last];
+            hasStarts[index] = hasStarts[last];
+            values[index] = values[last];
+            onCompletes[index] = std::move(onCompletes[last]);
+        }
+
+        targets.pop_back();
+        objects.pop_back();
+        properties.pop_back();
+        starts.pop_back();
+        changes.pop_back();
+        inverseDurations.pop_back();
+        elapsed.pop_back();
+        hasStarts.pop_back();
+        values.pop_back();
+        onCompletes.pop_back();
+    }
+
+    void Clear()
+    {
+        targets.clear();
+        objects.clear();
+        properties.clear();
+        starts.clear();
+        changes.clear();
+        inverseDurations.clear();
+        elapsed.clear();
+        hasStarts.clear();
+        values.clear();
+        onCompletes.clear();
+
+        pendingStartCount = 0;
+    }
+};
+
+class TweenSystem;
+
+/**
+ * Fluent description of a tween. The tween is started when the builder goes
+ * out of scope, usually at the end of the statement that created it.
+ *
+ * @code
+ * game->GetTweens()
+ *     .To(object.get(), TweenProperty::X, 200, 0.5)
+ *     .Ease(Easing::EASE_OUT_BACK)
+ *     .Delay(0.25)
+ *     .OnComplete([] { SDL_Log("Done"); });
+ * @endcode
+ */
+class TweenBuilder
+{
+  private:
+    TweenSystem *system;
+
+    TweenDefinition definition;
+
+  public:
+    TweenBuilder(TweenSystem *system, TweenDefinition definition)
+        : system(system), definition(std::move(definition))
+    {
+    }
+
+    TweenBuilder(const TweenBuilder &) = delete;
+    auto operator=(const TweenBuilder &) -> TweenBuilder & = delete;
+
+    TweenBuilder(TweenBuilder &&other) noexcept
+        : system(std::exchange(other.system, nullptr)),
+          definition(std::move(other.definition))
+    {
+    }
+
+    auto operator=(TweenBuilder &&) -> TweenBuilder & = delete;
+
+    inline ~TweenBuilder();
+
+    /**
+     * Set the easing curve, linear by default.
+     *
+     * @param easing Easing curve.
+     */
+    auto Ease(Easing easing) -> TweenBuilder &
+    {
+        definition.easing = easing;
+
+        return *this;
+    }
+
+    /**
+     * Wait before starting. The target isn't written to while waiting, and
+     * without From the start value is read once the wait is over.
+     *
+     * @param delay Delay in seconds.
+     */
+    auto Delay(double delay) -> TweenBuilder &
+    {
+        definition.delay = delay;
+
+        return *this;
+    }
+
+    /**
+     * Start from a value instead of the current value of the target.
+     *
+     * @param start Start value.
+     */
+    auto From(float start) -> TweenBuilder &
+    {
+        definition.start = start;
+        definition.hasStart = true;
+
+        return *this;
+    }
+
+    /**
+     * Call a function once the tween has written its end value.
+     *
+     * @param onComplete Function to call.
+     */
+    auto OnComplete(std::function<void()> onComplete) -> TweenBuilder &
+    {
+        definition.onComplete = std::move(onComplete);
+
+        return *this;
+    }
+};
+
+/**
+ * Steps many simple float tweens without a render object or a type erased
+ * call per tween. Tweens are grouped into a pool per easing curve, and each
+ * pool is stepped with one loop over contiguous arrays that the compiler can
+ * vectorize, before the results are written to their targets.
+ *
+ * Targets must outlive their tweens, or be killed with Kill first. Tweens on
+ * render object properties are removed automatically when the object is
+ * destroyed.
+ */
+class TweenSystem
+{
+  private:
+    Game *game = nullptr;
+
+    std::array<TweenPool, EASING_COUNT> pools;
+
+    std::vector<std::function<void()>> completed;
+
+    /**
+     * Read the start value of delayed tweens whose delay has run out, once
+     * every pool has written this step. They start from where the target is
+     * now, after any tween before them has finished, rather than where it
+     * was when the tween was created.
+     */
+    static void ReadPendingStarts(TweenPool &pool)
+    {
+        for (size_t i = 0; i < pool.GetCount(); i += 1)
+        {
+            if (pool.hasStarts[i] != 0 || pool.elapsed[i] < 0)
+            {
+                continue;
+            }
+
+            auto start = pool.properties[i] == TweenProperty::VALUE
+                             ? *pool.targets[i]
+                             : GetTweenProperty(pool.objects[i],
+                                                pool.properties[i]);
+
+            pool.starts[i] = start;
+            pool.changes[i] -= start;
+            pool.hasStarts[i] = 1;
+            pool.pendingStartCount -= 1;
+        }
+    }
+
+    template <Easing easing> void StepPool(TweenPool &pool, float deltaTime)
+    {
+        const auto count = pool.GetCount();
+
+        const auto *starts = pool.starts.data();
+        const auto *changes = pool.changes.data();
+        const auto *inverseDurations = pool.inverseDurations.data();
+
+        auto *elapsed = pool.elapsed.data();
+        auto *values = pool.values.data();
+
+        for (size_t i = 0; i < count; i += 1)
+        {
+            elapsed[i] += deltaTime;
+
+            auto t = std::clamp(elapsed[i] * inverseDurations[i], 0.0F, 1.0F);
+
+            values[i] = starts[i] + (changes[i] * Ease<easing>(t));
+        }
+
+        const auto *hasStarts = pool.hasStarts.data();
+
+        for (size_t i = 0; i < count; i += 1)
+        {
+            if (elapsed[i] < 0 || hasStarts[i] == 0)
+            {
+                continue;
+            }
+
+            if (pool.properties[i] == TweenProperty::VALUE)
+            {
+                *pool.targets[i] = values[i];
+            }
+            else
+            {
+                SetTweenProperty(pool.objects[i], pool.properties[i],
+                                 values[i]);
+            }
+        }
+
+        for (size_t i = count; i > 0; i -= 1)
+        {
+            if (hasStarts[i - 1] != 0 &&
+                elapsed[i - 1] * inverseDurations[i - 1] >= 1)
+            {
+                if (pool.onCompletes[i - 1])
+                {
+                    completed.push_back(std::move(pool.onCompletes[i - 1]));
+                }
+
+                pool.SwapRemove(i - 1);
+            }
+        }
+    }
+
+  public:
+    /**
+     * Create a tween system.
+     *
+     * @param game Game whose parallel update tweens started from an update
+     * are deferred until, if any.
+     */
+    explicit TweenSystem(Game *game = nullptr) : game(game)
+    {
+        for (auto &pool : pools)
+        {
+            pool.Reserve(DEFAULT_TWEEN_POOL_SIZE);
+        }
+    }
+
+    /**
+     * Tween a float to a value.
+     *
+     * @param target Float to write to.
+     * @param end End value.
+     * @param duration Duration in seconds.
+     */
+    auto To(float *target, float end, double duration) -> TweenBuilder
+    {
+        TweenDefinition definition;
+
+        definition.target = target;
+        definition.end = end;
+        definition.duration = duration;
+
+        return {this, std::move(definition)};
+    }
+
+    /**
+     * Tween a property of a render object to a value.
+     *
+     * @param object Render object to write to.
+     * @param property Property to tween.
+     * @param end End value.
+     * @param duration Duration in seconds.
+     */
+    auto To(RenderObject *object, TweenProperty property, float end,
+            double duration) -> TweenBuilder
+    {
+        TweenDefinition definition;
+
+        definition.object = object;
+        definition.property = property;
+        definition.end = end;
+        definition.duration = duration;
+
+        return {this, std::move(definition)};
+    }
+
+    /**
+     * Start a tween. Called by TweenBuilder.
+     *
+     * @param definition Tween to start.
+     */
+    void Add(TweenDefinition &&definition)
+    {
+        if (definition.property == TweenProperty::VALUE
+                ? definition.target == nullptr
+                : definition.object == nullptr)
+        {
+            return;
+        }
+
+        // Pools aren't thread safe, so tweens started from a parallel update
+        // are added once it has finished.
+        if (game != nullptr && IsTweenGameUpdatingInParallel(game))
+        {
+            DeferTweenCommand(
+                game, [this, definition = std::move(definition)]() mutable
+                { Add(std::move(definition)); });
+
+            return;
+        }
+
+        auto start = definition.start;
+
+        auto hasStart = definition.hasStart;
+
+        // Delayed tweens read their start value once they begin.
+        if (!hasStart && definition.delay <= 0)
+        {
+            start = definition.property == TweenProperty::VALUE
+                        ? *definition.target
+                        : GetTweenProperty(definition.object,
+                                           definition.property);
+
+            hasStart = true;
+        }
+
+        auto index = std::min(static_cast<size_t>(definition.easing),
+                              EASING_COUNT - 1);
+
+        pools[index].Add(std::move(definition), start, hasStart);
+    }
+
+    /**
+     * Advance every tween, write their values and call the completion
+     * functions of the ones that finished.
+     *
+     * @param deltaTime Seconds since the last step.
+     */
+    void Step(double deltaTime)
+    {
+        auto delta = static_cast<float>(deltaTime);
+
+        for (size_t i = 0; i < EASING_COUNT; i += 1)
+        {
+            auto &pool = pools[i];
+
+            if (pool.GetCount() == 0)
+            {
+                continue;
+            }
+
+            switch (static_cast<Easing>(i))
+            {
+            case Easing::EASE_IN_QUAD:
+                StepPool<Easing::EASE_IN_QUAD>(pool, delta);
+                break;
+            case Easing::EASE_OUT_QUAD:
+                StepPool<Easing::EASE_OUT_QUAD>(pool, delta);
+                break;
+            case Easing::EASE_IN_OUT_QUAD:
+                StepPool<Easing::EASE_IN_OUT_QUAD>(pool, delta);
+                break;
+            case Easing::EASE_IN_CUBIC:
+                StepPool<Easing::EASE_IN_CUBIC>(pool, delta);
+                break;
+            case Easing::EASE_OUT_CUBIC:
+                StepPool<Easing::EASE_OUT_CUBIC>(pool, delta);
+                break;
+            case Easing::EASE_IN_OUT_CUBIC:
+                StepPool<Easing::EASE_IN_OUT_CUBIC>(pool, delta);
+                break;
+            case Easing::EASE_IN_SINE:
+                StepPool<Easing::EASE_IN_SINE>(pool, delta);
+                break;
+            case Easing::EASE_OUT_SINE:
+                StepPool<Easing::EASE_OUT_SINE>(pool, delta);
+                break;
+            case Easing::EASE_IN_OUT_SINE:
+                StepPool<Easing::EASE_IN_OUT_SINE>(pool, delta);
+                break;
+            case Easing::EASE_IN_BACK:
+                StepPool<Easing::EASE_IN_BACK>(pool, delta);
+                break;
+            case Easing::EASE_OUT_BACK:
+                StepPool<Easing::EASE_OUT_BACK>(pool, delta);
+                break;
+            case Easing::EASE_OUT_BOUNCE:
+                StepPool<Easing::EASE_OUT_BOUNCE>(pool, delta);
+                break;
+            default:
+                StepPool<Easing::LINEAR>(pool, delta);
+                break;
+            }
+        }
+
+        for (auto &pool : pools)
+        {
+            if (pool.pendingStartCount > 0)
+            {
+                ReadPendingStarts(pool);
+            }
+        }
+
+        // Called after every pool has been stepped so completion functions
+        // can start new tweens.
+        for (auto &onComplete : completed)
+        {
+            onComplete();
+        }
+
+        completed.clear();
+    }
+
+    /**
+     * Stop every tween writing to a float, without completing them.
+     *
+     * @param target Float the tweens write to.
+     */
+    void Kill(const float *target)
+    {
+        for (auto &pool : pools)
+        {
+            for (size_t i = pool.GetCount(); i > 0; i -= 1)
+            {
+                if (pool.targets[i - 1] == target)
+                {
+                    pool.SwapRemove(i - 1);
+                }
+            }
+        }
+    }
+
+    /**
+     * Stop every tween writing to a render object, without completing them.
+     *
+     * @param object Render object the tweens write to.
+     */
+    void Kill(const RenderObject *object)
+    {
+        for (auto &pool : pools)
+        {
+            for (size_t i = pool.GetCount(); i > 0; i -= 1)
+            {
+                if (pool.objects[i - 1] == object)
+                {
+                    pool.SwapRemove(i - 1);
+                }
+            }
+        }
+    }
+
+    /**
+     * Stop tweens writing to render objects that are about to be destroyed.
+     * Called by the game before destroyed objects are released.
+     */
+    void KillDestroyed()
+    {
+        for (auto &pool : pools)
+        {
+            for (size_t i = pool.GetCount(); i > 0; i -= 1)
+            {
+                if (pool.objects[i - 1] != nullptr &&
+                    IsTweenObjectDestroyed(pool.objects[i - 1]))
+                {
+                    pool.SwapRemove(i - 1);
+                }
+            }
+        }
+    }
+
+    void KillAll()
+    {
+        for (auto &pool : pools)
+        {
+            pool.Clear();
+        }
+    }
+
+    [[nodiscard]] auto GetActiveCount() const -> size_t
+    {
+        size_t count = 0;
+
+        for (const auto &pool : pools)
+        {
+            count += pool.GetCount();
+        }
+
+        return count;
+    }
+};
+
+TweenBuilder::~TweenBuilder()
+{
+    if (system != nullptr)
+    {
+        system->Add(std::move(definition));
+    }
+}
+
+} // namespace HandcrankEngine
@@ -16,6 +16,7 @@
 #include <random>
 #include <regex>
 #include <string>
+#include <typeinfo>
 
 namespace HandcrankEngine
 {
@@ -119,9 +120,9 @@ inline auto RandomColorRange(const SDL_Color min, const SDL_Color max)
 
 inline auto RandomBoolean() -> bool { return rand() > (RAND_MAX / 2); }
 
-template <typename T> auto GetClassNameSimple(const T &obj) -> std::string
+inline auto GetTypeNameSimple(const std::type_info &type) -> std::string
 {
-    std::string rawName = typeid(obj).name();
+    std::string rawName = type.name();
 
     std::regex pattern("([0-9]+)$");
 
@@ -153,12 +154,38 @@ template <typename T> auto GetClassNameSimple(const T &obj) -> std::string
     return rawName;
 }
 
+template <typename T> auto GetClassNameSimple(const T &obj) -> std::string
+{
+    return GetTypeNameSimple(typeid(obj));
+}
+
 inline auto MemHash(const void *mem, const size_t size) -> size_t
 {
     return std::hash<std::string_view>{}(
         std::string_view(static_cast<const char *>(mem), size));
 }
 
+/**
+ * Get the size of a file in bytes, or 0 if it can't be opened.
+ *
+ * @param path File path.
+ */
+inline auto GetFileSize(const char *path) -> size_t
+{
+    auto *rw = SDL_RWFromFile(path, "rb");
+
+    if (rw == nullptr)
+    {
+        return 0;
+    }
+
+    auto size = SDL_RWsize(rw);
+
+    SDL_RWclose(rw);
+
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
 inline auto ToString(const SDL_Rect &rect) -> std::string
 {
     return "SDL_Rect(" + std::to_string(rect.x) + ", " +
@@ -180,13 +207,8 @@ inline auto GenerateTextureQuad(std::vector<SDL_Vertex> &vertices,
                                 const SDL_Color &color, float textureWidth,
                                 float textureHeight) -> void
 {
-    const size_t vertices_size = 4;
-    const size_t indices_size = 6;
-
     auto index = vertices.size();
 
-    vertices.reserve(vertices.size() + vertices_size);
-
     vertices.emplace_back(
         SDL_Vertex{{destRect.x, destRect.y},
                    color,
@@ -205,8 +227,6 @@ inline auto GenerateTextureQuad(std::vector<SDL_Vertex> &vertices,
         color,
         {srcRect.x / textureWidth, (srcRect.y + srcRect.h) / textureHeight}});
 
-    indices.reserve(indices.size() + indices_size);
-
     indices.emplace_back(static_cast<int>(index));
     indices.emplace_back(static_cast<int>(index + 1));
     indices.emplace_back(static_cast<int>(index + 2));
@@ -232,4 +252,20 @@ inline auto UpdateTextureQuad(SDL_Vertex *vertices_ptr,
     vertices_ptr[3].position.y = destRect.y + destRect.h;
 }
 
+inline auto FlipTextureQuad(SDL_Vertex *vertices_ptr,
+                            const SDL_RendererFlip flip) -> void
+{
+    if ((flip & SDL_FLIP_HORIZONTAL) == SDL_FLIP_HORIZONTAL)
+    {
+        std::swap(vertices_ptr[0].tex_coord.x, vertices_ptr[1].tex_coord.x);
+        std::swap(vertices_ptr[3].tex_coord.x, vertices_ptr[2].tex_coord.x);
+    }
+
+    if ((flip & SDL_FLIP_VERTICAL) == SDL_FLIP_VERTICAL)
+    {
+        std::swap(vertices_ptr[0].tex_coord.y, vertices_ptr[3].tex_coord.y);
+        std::swap(vertices_ptr[1].tex_coord.y, vertices_ptr[2].tex_coord.y);
+    }
+}
+
 } // namespace HandcrankEngine
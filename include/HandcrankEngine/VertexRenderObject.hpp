@@ -34,13 +34,49 @@ class VertexRenderObject : public TextureRenderObject
 
     std::vector<VertexRenderItem> vertexRenderItems;
 
+    // Vertices with texture coordinates mapped into the atlas page, rebuilt
+    // each render so they follow the region when the atlas is repacked.
+    std::vector<SDL_Vertex> regionVertices;
+
   public:
     using TextureRenderObject::TextureRenderObject;
 
+    [[nodiscard]] auto GetInstanceSize() const -> size_t override
+    {
+        return sizeof(VertexRenderObject);
+    }
+
+    /**
+     * Include the vertex, index and render item buffers.
+     */
+    [[nodiscard]] auto GetResourceBytes() const -> size_t override
+    {
+        return TextureRenderObject::GetResourceBytes() +
+               vertices.capacity() * sizeof(SDL_Vertex) +
+               indices.capacity() * sizeof(int) +
+               vertexRenderItems.capacity() * sizeof(VertexRenderItem) +
+               regionVertices.capacity() * sizeof(SDL_Vertex);
+    }
+
     void Render(SDL_Renderer *renderer) override
     {
-        SDL_RenderGeometry(game->GetRenderer(), texture, vertices.data(),
+        game->FlushRenderBatch();
+
+        auto *renderTexture = GetRenderTexture();
+
+        const auto *renderVertices = vertices.data();
+
+        if (textureRegion != nullptr && textureRegion->textureWidth > 0 &&
+            textureRegion->textureHeight > 0)
+        {
+            MapVerticesToTextureRegion();
+
+            renderVertices = regionVertices.data();
+        }
+
+        SDL_RenderGeometry(game->GetRenderer(), renderTexture, renderVertices,
                            vertices.size(), indices.data(), indices.size());
+        HANDCRANK_RENDER_CALL(renderTexture);
 
         RenderObject::Render(renderer);
     }
@@ -58,6 +94,29 @@ class VertexRenderObject : public TextureRenderObject
     {
         UpdateTextureQuad(vertices.data() + (index * 4), position);
     }
+
+  private:
+    /**
+     * Texture coordinates are generated relative to the region, so offset
+     * and scale them into the page the region currently lives on.
+     */
+    void MapVerticesToTextureRegion()
+    {
+        const auto &rect = textureRegion->rect;
+
+        auto pageWidth = static_cast<float>(textureRegion->textureWidth);
+        auto pageHeight = static_cast<float>(textureRegion->textureHeight);
+
+        regionVertices.assign(vertices.begin(), vertices.end());
+
+        for (auto &vertex : regionVertices)
+        {
+            vertex.tex_coord.x =
+                (rect.x + vertex.tex_coord.x * rect.w) / pageWidth;
+            vertex.tex_coord.y =
+                (rect.y + vertex.tex_coord.y * rect.h) / pageHeight;
+        }
+    }
 };
 
 } // namespace HandcrankEngine
@@ -1,3 +1,5 @@
+#define HANDCRANK_ENGINE_TRACK_ALLOCATIONS_IMPLEMENTATION
+
 #include "HandcrankEngine/HandcrankEngine.hpp"
 
 using namespace HandcrankEngine;